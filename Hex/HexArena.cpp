@@ -0,0 +1,90 @@
+//
+//  HexArena.cpp
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#include "HexArena.h"
+
+#include <algorithm>
+#include <cassert>
+#include <stdint.h>
+
+/// コンストラクタ
+HexArena::HexArena(std::size_t block_size)
+:m_block_size(block_size)
+,m_blocks()
+,m_current(0)
+,m_offset(0)
+,m_used(0)
+{}
+
+/// デストラクタ
+HexArena::~HexArena()
+{
+    release();
+}
+
+/// 領域を確保する
+void* HexArena::Allocate(std::size_t size, std::size_t align)
+{
+    assert((align != 0) && ((align & (align - 1)) == 0));
+    for (;;) {
+        if (m_current < m_blocks.size()) {
+            const Block& block = m_blocks[m_current];
+            const uintptr_t address = reinterpret_cast<uintptr_t>(block.data) + m_offset;
+            const std::size_t padding = (align - (address & (align - 1))) & (align - 1);
+            if (m_offset + padding + size <= block.size) {
+                void* p = block.data + m_offset + padding;
+                m_offset += padding + size;
+                return p;
+            }
+            // 次のブロックへ移る 使い終えたブロックの大きさを数えておく
+            m_used += m_offset;
+            m_offset = 0;
+            ++m_current;
+            if (m_current < m_blocks.size()) { continue; }
+        }
+        addBlock(std::max(m_block_size, size + align));
+    }
+}
+
+/// 全領域を巻き戻す
+void HexArena::Reset()
+{
+    if (1 < m_blocks.size()) {
+        // 次も同じだけ使うとみなし, 一つのブロックにまとめる
+        const std::size_t capacity = GetCapacity();
+        release();
+        addBlock(capacity);
+    }
+    m_current = 0;
+    m_offset  = 0;
+    m_used    = 0;
+}
+
+/// 確保済みの大きさ取得
+std::size_t HexArena::GetCapacity() const
+{
+    std::size_t capacity(0);
+    for (std::size_t i(0); i < m_blocks.size(); ++i) { capacity += m_blocks[i].size; }
+    return capacity;
+}
+
+/// ブロックを足す
+void HexArena::addBlock(std::size_t size)
+{
+    Block block;
+    block.data = new unsigned char[size];
+    block.size = size;
+    m_blocks.push_back(block);
+}
+
+/// 全ブロックを解放する
+void HexArena::release()
+{
+    for (std::size_t i(0); i < m_blocks.size(); ++i) { delete[] m_blocks[i].data; }
+    m_blocks.clear();
+}
@@ -0,0 +1,83 @@
+//
+//  HexArena.h
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#ifndef Hex_HexArena_h
+#define Hex_HexArena_h
+
+#include <cstddef>
+#include <vector>
+
+/// @class 単調増加のメモリ領域
+/// 確保は領域の末尾を進めるだけで, 個別には解放せずReset()でまとめて巻き戻す
+/// 領域が足りなくなったら新しいブロックを足す 巻き戻すときに複数のブロックを使っていれば,
+/// 使った大きさの一つのブロックにまとめ直すので, 同じ使い方を繰り返せば以降はメモリを確保しない
+/// 確保した領域ではコンストラクタもデストラクタも呼ばないので, 組み込み型などの単純な型に使う
+class HexArena
+{
+public:
+    /// コンストラクタ
+    /// 最初の確保まではメモリを確保しない
+    /// @param block_size [in] 新しいブロックの最小の大きさ
+    explicit HexArena(std::size_t block_size = 64 * 1024);
+
+    /// デストラクタ
+    ~HexArena();
+
+    /// 領域を確保する
+    /// @param size [in] 大きさ
+    /// @param align [in] 境界 2の冪
+    /// @retval 確保した領域の先頭
+    void* Allocate(std::size_t size, std::size_t align);
+
+    /// 配列を確保する
+    /// 要素は初期化しない
+    /// @tparam T 要素の型
+    /// @param count [in] 要素数
+    /// @retval 配列の先頭
+    template <class T>
+    T* AllocateArray(std::size_t count)
+    {
+        return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /// 全領域を巻き戻す
+    /// それまでに確保した領域はすべて無効になる
+    void Reset();
+
+    /// 使っている大きさ取得
+    std::size_t GetUsed() const { return m_used + m_offset; }
+    /// 確保済みの大きさ取得
+    std::size_t GetCapacity() const;
+
+private:
+    /// ブロック
+    struct Block
+    {
+        unsigned char* data; /// 先頭
+        std::size_t size;    /// 大きさ
+    };
+
+    /// ブロックを足す
+    /// @param size [in] 大きさ
+    void addBlock(std::size_t size);
+
+    /// 全ブロックを解放する
+    void release();
+
+    // コピー禁止
+    HexArena(const HexArena&);
+    HexArena& operator=(const HexArena&);
+
+    std::size_t m_block_size;   /// 新しいブロックの最小の大きさ
+    std::vector<Block> m_blocks;/// ブロック
+    std::size_t m_current;      /// 使っているブロック
+    std::size_t m_offset;       /// 使っているブロックの使った大きさ
+    std::size_t m_used;         /// 使い終えたブロックの使った大きさの合計
+};
+
+#endif
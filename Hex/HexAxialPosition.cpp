@@ -0,0 +1,14 @@
+//
+//  HexAxialPosition.cpp
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#include "HexAxialPosition.h"
+
+/// 隣へのq座標の差分
+constexpr int HexAxialPosition::s_neighbor_q[];
+/// 隣へのr座標の差分
+constexpr int HexAxialPosition::s_neighbor_r[];
@@ -0,0 +1,212 @@
+//
+//  HexAxialPosition.h
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#ifndef Hex_HexAxialPosition_h
+#define Hex_HexAxialPosition_h
+
+#include "HexMapPosition.h"
+
+#include <cmath>
+
+/// 小数の立方座標
+/// 直線の補間に使う q + r + s = 0
+struct HexCubeFraction
+{
+    /// コンストラクタ
+    constexpr HexCubeFraction(double q_, double r_, double s_)
+    :q(q_)
+    ,r(r_)
+    ,s(s_)
+    {}
+
+    double q, r, s;
+};
+
+/// ヘックスの斜交座標位置
+/// HexMapPositionの奇数行を右にずらした配置を, 行の偶奇で分岐しない座標に置き換えたもの
+/// q軸は右, r軸は右下 立方座標の三つ目の軸は s = -q - r
+class HexAxialPosition
+{
+public:
+    /// コンストラクタ
+    constexpr HexAxialPosition()
+    :m_q(0)
+    ,m_r(0)
+    {}
+
+    /// コンストラクタ
+    /// @param q [in] q座標
+    /// @param r [in] r座標
+    constexpr HexAxialPosition(int q, int r)
+    :m_q(q)
+    ,m_r(r)
+    {}
+
+    /// ヘックスマップ位置から変換
+    /// @param pos [in] ヘックスマップ位置
+    /// @retval 斜交座標位置
+    static constexpr HexAxialPosition FromOffset(const HexMapPosition& pos)
+    {
+        return HexAxialPosition(pos.X() - ((pos.Y() - (pos.Y() & 1)) >> 1), pos.Y());
+    }
+
+    /// ヘックスマップ位置へ変換
+    /// @retval ヘックスマップ位置
+    constexpr HexMapPosition ToOffset() const
+    {
+        return HexMapPosition(m_q + ((m_r - (m_r & 1)) >> 1), m_r);
+    }
+
+    /// q座標を取得
+    constexpr int Q() const { return m_q; }
+    /// r座標を取得
+    constexpr int R() const { return m_r; }
+    /// 立方座標の三つ目の座標を取得
+    constexpr int S() const { return -m_q - m_r; }
+
+    /// 隣を取得
+    /// 隣への差分は行の偶奇によらないので表を引くだけでよい
+    /// @param n [in] 隣指定
+    /// @retval 隣の位置
+    constexpr HexAxialPosition GetNeighbor(HexMapPosition::Neighbor n) const
+    {
+        return HexAxialPosition(m_q + s_neighbor_q[n], m_r + s_neighbor_r[n]);
+    }
+
+    /// 加算
+    constexpr HexAxialPosition operator+(const HexAxialPosition& pos) const
+    {
+        return HexAxialPosition(m_q + pos.m_q, m_r + pos.m_r);
+    }
+
+    /// 減算
+    constexpr HexAxialPosition operator-(const HexAxialPosition& pos) const
+    {
+        return HexAxialPosition(m_q - pos.m_q, m_r - pos.m_r);
+    }
+
+    /// 一致比較
+    constexpr bool operator==(const HexAxialPosition& pos) const
+    {
+        return (m_q == pos.m_q) && (m_r == pos.m_r);
+    }
+
+    /// 非一致比較
+    constexpr bool operator!=(const HexAxialPosition& pos) const
+    {
+        return (m_q != pos.m_q) || (m_r != pos.m_r);
+    }
+
+    /// 二つの位置のヘックス距離を取得
+    /// @param a [in] 位置
+    /// @param b [in] 位置
+    /// @retval 距離
+    static constexpr int Distance(const HexAxialPosition& a, const HexAxialPosition& b)
+    {
+        return (abs(a.m_q - b.m_q) + abs(a.m_r - b.m_r) + abs(a.S() - b.S())) / 2;
+    }
+
+    /// 二つの位置を結ぶ線分上の点を取得
+    /// @param a [in] 始点
+    /// @param b [in] 終点
+    /// @param t [in] 補間係数 0で始点 1で終点
+    /// @retval 小数の立方座標
+    static constexpr HexCubeFraction Lerp(const HexAxialPosition& a, const HexAxialPosition& b, double t)
+    {
+        return HexCubeFraction(a.m_q + (b.m_q - a.m_q) * t,
+                               a.m_r + (b.m_r - a.m_r) * t,
+                               a.S() + (b.S() - a.S()) * t);
+    }
+
+    /// 小数の立方座標を含むヘックスを取得
+    /// 各軸を丸めた後, 丸め誤差が最も大きい軸を残りの二軸から決め直す
+    /// @param f [in] 小数の立方座標
+    /// @retval 位置
+    static HexAxialPosition Round(const HexCubeFraction& f)
+    {
+        double q = std::floor(f.q + 0.5);
+        double r = std::floor(f.r + 0.5);
+        const double s = std::floor(f.s + 0.5);
+
+        const double dq = std::fabs(q - f.q);
+        const double dr = std::fabs(r - f.r);
+        const double ds = std::fabs(s - f.s);
+        if ((ds < dq) && (dr < dq)) { q = -r - s; }
+        else if (ds < dr)           { r = -q - s; }
+        return HexAxialPosition(static_cast<int>(q), static_cast<int>(r));
+    }
+
+    /// 範囲内にあるか否か
+    /// @param center [in] 中心
+    /// @param pos [in] 位置
+    /// @param radius [in] 半径
+    /// @retval 中心からの距離が半径以下ならばtrue そうでなければfalse
+    static constexpr bool InRange(const HexAxialPosition& center, const HexAxialPosition& pos, int radius)
+    {
+        return Distance(center, pos) <= radius;
+    }
+
+    /// 範囲内の位置の数を取得
+    /// @param radius [in] 半径
+    /// @retval 中心からの距離が半径以下の位置の数
+    static constexpr int RangeSize(int radius)
+    {
+        return 3 * radius * (radius + 1) + 1;
+    }
+
+    /// 範囲内の位置を列挙する
+    /// @tparam OutputIterator HexAxialPositionを受け取る出力イテレータ
+    /// @param center [in] 中心
+    /// @param radius [in] 半径
+    /// @param out [out] 出力先
+    /// @retval 出力後の出力イテレータ
+    template <class OutputIterator>
+    static OutputIterator Range(const HexAxialPosition& center, int radius, OutputIterator out)
+    {
+        for (int dq(-radius); dq <= radius; ++dq) {
+            const int r_min = (-radius < -dq - radius) ? -dq - radius : -radius;
+            const int r_max = (radius < -dq + radius) ? radius : -dq + radius;
+            for (int dr(r_min); dr <= r_max; ++dr) {
+                *out = HexAxialPosition(center.m_q + dq, center.m_r + dr);
+                ++out;
+            }
+        }
+        return out;
+    }
+
+private:
+    /// 絶対値
+    static constexpr int abs(int v) { return (v < 0) ? -v : v; }
+
+    /// 隣へのq座標の差分 HexMapPosition::Neighbor順
+    static constexpr int s_neighbor_q[HexMapPosition::NeighborCount] = { 1, 1, 0, -1, -1, 0 };
+    /// 隣へのr座標の差分 HexMapPosition::Neighbor順
+    static constexpr int s_neighbor_r[HexMapPosition::NeighborCount] = { -1, 0, 1, 1, 0, -1 };
+
+    int m_q; /// q座標
+    int m_r; /// r座標
+};
+
+/// 二つの位置のヘックス距離を取得
+/// 地形を考慮しない最短の歩数
+/// @param a [in] 位置
+/// @param b [in] 位置
+/// @retval 距離
+constexpr int HexDistance(const HexMapPosition& a, const HexMapPosition& b)
+{
+    return HexAxialPosition::Distance(HexAxialPosition::FromOffset(a), HexAxialPosition::FromOffset(b));
+}
+
+/// 出力オペレータ
+inline std::ostream& operator<<(std::ostream& os, const HexAxialPosition& pos)
+{
+    os << '[' << pos.Q() << ',' << pos.R() << ']';
+    return os;
+}
+
+#endif
@@ -0,0 +1,146 @@
+//
+//  HexBitMap.h
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#ifndef Hex_HexBitMap_h
+#define Hex_HexBitMap_h
+
+#include "HexMapPosition.h"
+
+#include <algorithm>
+#include <cassert>
+#include <stdint.h>
+#include <vector>
+
+/// @class 一マス一ビットのヘックスマップ
+/// 侵入可否などの二値の層に使う
+/// 各行を64ビットの語の並びで持ち, 行の先頭は必ず語の先頭に揃える
+/// x 番目の位置は行の (x / 64) 語目の (x % 64) ビット目 幅を超えるビットは常に0
+class HexBitMap
+{
+public:
+    /// コンストラクタ
+    HexBitMap()
+    :m_width(0)
+    ,m_height(0)
+    ,m_word_count(0)
+    ,m_words()
+    {}
+
+    /// コンストラクタ
+    /// 全ビット0で生成する
+    /// @param width [in] 幅
+    /// @param height [in] 高さ
+    HexBitMap(int width, int height)
+    :m_width(0)
+    ,m_height(0)
+    ,m_word_count(0)
+    ,m_words()
+    {
+        Resize(width, height);
+    }
+
+    /// 大きさ変更
+    /// 全ビット0に戻る
+    /// @param width [in] 幅
+    /// @param height [in] 高さ
+    void Resize(int width, int height)
+    {
+        assert((0 <= width) && (0 <= height));
+        m_width      = width;
+        m_height     = height;
+        m_word_count = (width + 63) / 64;
+        m_words.assign(static_cast<std::size_t>(m_word_count) * height, 0);
+    }
+
+    /// 全ビット0にする
+    void Clear() { std::fill(m_words.begin(), m_words.end(), uint64_t(0)); }
+
+    /// ビット取得
+    /// 範囲の判定をしない
+    /// @param pos [in] 位置
+    bool Get(const HexMapPosition& pos) const
+    {
+        return ((word(pos) >> (pos.X() % 64)) & 1) != 0;
+    }
+
+    /// ビット取得
+    bool operator[](const HexMapPosition& pos) const { return Get(pos); }
+
+    /// ビット設定
+    /// 範囲の判定をしない
+    /// @param pos [in] 位置
+    /// @param value [in] 値
+    void Set(const HexMapPosition& pos, bool value)
+    {
+        const uint64_t bit = uint64_t(1) << (pos.X() % 64);
+        uint64_t& w = word(pos);
+        w = value ? (w | bit) : (w & ~bit);
+    }
+
+    /// 一行分の語の先頭を取得
+    /// @param y [in] 行
+    uint64_t*       GetRow(int y)       { return &m_words[static_cast<std::size_t>(m_word_count) * y]; }
+    const uint64_t* GetRow(int y) const { return &m_words[static_cast<std::size_t>(m_word_count) * y]; }
+
+    /// 一行分の語数取得
+    int GetWordCount() const { return m_word_count; }
+
+    /// 立っているビットの数を取得
+    int Count() const
+    {
+        int count(0);
+        for (std::size_t i(0); i < m_words.size(); ++i) { count += popcount(m_words[i]); }
+        return count;
+    }
+
+    /// 幅取得
+    int GetWidth() const { return m_width; }
+    /// 高さ取得
+    int GetHeight() const { return m_height; }
+    /// 大きさ取得
+    int Size() const { return m_width * m_height; }
+
+private:
+    /// 位置を含む語を取得
+    uint64_t&       word(const HexMapPosition& pos)       { return GetRow(pos.Y())[pos.X() / 64]; }
+    const uint64_t& word(const HexMapPosition& pos) const { return GetRow(pos.Y())[pos.X() / 64]; }
+
+    /// 立っているビットの数
+    static int popcount(uint64_t v)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(v);
+#else
+        int count(0);
+        for (; v != 0; v &= v - 1) { ++count; }
+        return count;
+#endif
+    }
+
+    int m_width;      /// 幅
+    int m_height;     /// 高さ
+    int m_word_count; /// 一行分の語数
+
+    /// 各行の語
+    std::vector<uint64_t> m_words;
+};
+
+/// 侵入可否の層のその位置に侵入可能であるか否かを判定する
+/// @param passable [in] 侵入可能な位置のビットが立った層
+/// @param pos [in] 位置
+inline bool IsEntriable(const HexBitMap& passable, const HexMapPosition& pos)
+{
+    if (pos.X() < 0) { return false; }
+    if (pos.Y() < 0) { return false; }
+    if (passable.GetWidth() <= pos.X())  { return false; }
+    if (passable.GetHeight() <= pos.Y()) { return false; }
+
+    return passable[pos];
+}
+
+#endif
@@ -12,5 +12,20 @@
 const std::string HexChip::s_names[] =
 {
     "OO",
-    "XX"
+    "XX",
+    "==",
+    "FF",
+    "~~"
 };
+
+/// 地形を表す文字から地形タイプを取得
+bool HexChip::FromString(const char* text, std::size_t length, Type& type)
+{
+    for (int i(0); i < Count; ++i) {
+        if (s_names[i].compare(0, std::string::npos, text, length) == 0) {
+            type = static_cast<Type>(i);
+            return true;
+        }
+    }
+    return false;
+}
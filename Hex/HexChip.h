@@ -19,8 +19,11 @@ public:
     /// 地形タイプ
     enum Type
     {
-        Standard = 0,
-        NoEntry,
+        Standard = 0, /// 平地
+        NoEntry,      /// 侵入不可
+        Road,         /// 道
+        Forest,       /// 森
+        Swamp,        /// 沼
         Count
     };
     
@@ -32,9 +35,6 @@ public:
         
     }
     
-    /// デストラクタ
-    ~HexChip(){ }
-    
     /// 地形タイプ取得
     /// @retval 地形タイプ
     Type GetType() const
@@ -52,13 +52,28 @@ public:
     /// 地形タイプ
     operator Type() const { return m_type; }
     
+    /// 地形を表す文字から地形タイプを取得
+    /// @param text [in] 文字の先頭
+    /// @param length [in] 文字数
+    /// @param type [out] 地形タイプ
+    /// @retval 一致する地形があればtrue なければfalse
+    static bool FromString(const char* text, std::size_t length, Type& type);
+    
     /// 地形を表す文字を取得
+    /// 名前の表を参照するので複製しない
     ///  @retval 文字
-    std::string GetString() const
+    const std::string& GetString() const
     {
         return s_names[m_type];
     }
     
+    /// 地形を表す文字をC文字列で取得
+    /// @retval 文字 終端文字付き 書き換えないこと
+    const char* GetName() const
+    {
+        return s_names[m_type].c_str();
+    }
+    
 private:
     /// 地形タイプ
     Type m_type;
@@ -0,0 +1,240 @@
+//
+//  HexComponentMap.cpp
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#include "HexComponentMap.h"
+
+#include <algorithm>
+#include <cassert>
+
+const int HexComponentMap::NoComponent;
+
+/// コンストラクタ
+HexComponentMap::HexComponentMap()
+:m_width(0)
+,m_height(0)
+,m_count(0)
+,m_generation(0)
+{}
+
+/// 侵入可能であるか否かを変更する
+void HexComponentMap::SetPassable(const HexMapPosition& pos, bool passable)
+{
+    assert(contains(pos));
+    const int index = indexOf(pos);
+    if ((0 <= m_label[index]) == passable) { return; }
+
+    if (passable) {
+        join(pos);
+    } else {
+        --m_size[findCompress(m_label[index])];
+        m_label[index] = NoComponent;
+        split(pos);
+    }
+
+    // 付け替えで使わなくなったラベルが増えすぎたら詰める
+    if (m_label.size() * 2 + 64 < m_parent.size()) { compact(); }
+}
+
+/// 大きさを変えて全位置を侵入不可にする
+void HexComponentMap::resize(int width, int height)
+{
+    m_width  = width;
+    m_height = height;
+    m_count  = 0;
+    m_label.assign(width * height, NoComponent);
+    m_parent.clear();
+    m_size.clear();
+    m_stamp.assign(width * height, 0);
+    m_group.assign(width * height, 0);
+    m_generation = 0;
+}
+
+/// 位置を侵入可能にし, 侵入可能な隣と併合する
+void HexComponentMap::join(const HexMapPosition& pos)
+{
+    const int label = newLabel();
+    m_label[indexOf(pos)] = label;
+    ++m_count;
+    for (int i(0); i < HexMapPosition::NeighborCount; ++i) {
+        const HexMapPosition neighbor = pos.GetNeighbor(static_cast<HexMapPosition::Neighbor>(i));
+        if (! contains(neighbor)) { continue; }
+        const int other = m_label[indexOf(neighbor)];
+        if (other < 0) { continue; }
+        if (unite(label, other)) { --m_count; }
+    }
+}
+
+/// ラベルを連結成分の代表に付け替え, 使わなくなったラベルを捨てる
+void HexComponentMap::compact()
+{
+    std::vector<int> renumber(m_parent.size(), NoComponent);
+    std::vector<int> size;
+    for (std::size_t i(0); i < m_label.size(); ++i) {
+        if (m_label[i] < 0) { continue; }
+        const int root = findCompress(m_label[i]);
+        if (renumber[root] < 0) {
+            renumber[root] = static_cast<int>(size.size());
+            size.push_back(0);
+        }
+        m_label[i] = renumber[root];
+        ++size[renumber[root]];
+    }
+
+    m_parent.resize(size.size());
+    for (std::size_t i(0); i < m_parent.size(); ++i) { m_parent[i] = static_cast<int>(i); }
+    m_size.swap(size);
+    m_count = static_cast<int>(m_parent.size());
+}
+
+/// 侵入不可にした位置の周りが分断されていればラベルを付け替える
+void HexComponentMap::split(const HexMapPosition& pos)
+{
+    // 隣は一周して並んでいて, 並びで隣り合う隣同士も隣り合う
+    // 侵入可能な隣が一続きならば, この位置を通らずに行き来できる
+    bool passable[HexMapPosition::NeighborCount];
+    HexMapPosition neighbors[HexMapPosition::NeighborCount];
+    int passable_count(0);
+    for (int i(0); i < HexMapPosition::NeighborCount; ++i) {
+        neighbors[i] = pos.GetNeighbor(static_cast<HexMapPosition::Neighbor>(i));
+        passable[i]  = contains(neighbors[i]) && (0 <= m_label[indexOf(neighbors[i])]);
+        if (passable[i]) { ++passable_count; }
+    }
+    if (passable_count == 0) {
+        // 孤立した位置が消えた
+        --m_count;
+        return;
+    }
+
+    // 区間の先頭を集める
+    int arc_count(0);
+    int root[MaxArcCount];
+    for (int i(0); i < HexMapPosition::NeighborCount; ++i) {
+        const int previous = (i + HexMapPosition::NeighborCount - 1) % HexMapPosition::NeighborCount;
+        if (! passable[i] || passable[previous]) { continue; }
+        m_queue[arc_count].clear();
+        m_queue[arc_count].push_back(indexOf(neighbors[i]));
+        root[arc_count] = arc_count;
+        ++arc_count;
+    }
+    if (arc_count <= 1) { return; }
+
+    if (++m_generation == 0) {
+        std::fill(m_stamp.begin(), m_stamp.end(), 0);
+        m_generation = 1;
+    }
+    for (int g(0); g < arc_count; ++g) {
+        m_stamp[m_queue[g][0]] = m_generation;
+        m_group[m_queue[g][0]] = g;
+    }
+
+    // 各区間から一つずつ交互に広げ, 出会った区間は一つにまとめる
+    // 尽きた区間は他と繋がっていないので, 広げている区間が一つになったら止める
+    std::size_t head[MaxArcCount] = {};
+    for (;;) {
+        int distinct(0);
+        int alive(0);
+        for (int g(0); g < arc_count; ++g) {
+            if (root[g] != g) { continue; }
+            ++distinct;
+            for (int h(0); h < arc_count; ++h) {
+                if ((root[h] == g) && (head[h] < m_queue[h].size())) { ++alive; break; }
+            }
+        }
+        if (distinct == 1) { return; }
+        if (alive <= 1) { break; }
+
+        for (int g(0); g < arc_count; ++g) {
+            if (m_queue[g].size() <= head[g]) { continue; }
+            const int index = m_queue[g][head[g]++];
+            const HexMapPosition pivot(index % m_width, index / m_width);
+            for (int i(0); i < HexMapPosition::NeighborCount; ++i) {
+                const HexMapPosition neighbor = pivot.GetNeighbor(static_cast<HexMapPosition::Neighbor>(i));
+                if (! contains(neighbor)) { continue; }
+                const int next = indexOf(neighbor);
+                if (m_label[next] < 0) { continue; }
+                if (m_stamp[next] == m_generation) {
+                    // 出会った区間をまとめる 区間は高々3つなので付け替えで足りる
+                    const int from = root[m_group[next]];
+                    const int to   = root[g];
+                    if (from == to) { continue; }
+                    for (int h(0); h < arc_count; ++h) {
+                        if (root[h] == from) { root[h] = to; }
+                    }
+                    continue;
+                }
+                m_stamp[next] = m_generation;
+                m_group[next] = g;
+                m_queue[g].push_back(next);
+            }
+        }
+    }
+
+    // 広げている区間か, 全部尽きたならば最も大きい区間に元のラベルを残す
+    int keep(-1);
+    std::size_t keep_size(0);
+    for (int g(0); g < arc_count; ++g) {
+        if (root[g] != g) { continue; }
+        bool alive(false);
+        std::size_t size(0);
+        for (int h(0); h < arc_count; ++h) {
+            if (root[h] != g) { continue; }
+            alive = alive || (head[h] < m_queue[h].size());
+            size += m_queue[h].size();
+        }
+        if (alive) { size = m_label.size(); }
+        if ((keep < 0) || (keep_size < size)) {
+            keep      = g;
+            keep_size = size;
+        }
+    }
+
+    for (int g(0); g < arc_count; ++g) {
+        if ((root[g] != g) || (g == keep)) { continue; }
+        const int label = newLabel();
+        m_size[label] = 0;
+        ++m_count;
+        for (int h(0); h < arc_count; ++h) {
+            if (root[h] != g) { continue; }
+            for (std::size_t i(0); i < m_queue[h].size(); ++i) { m_label[m_queue[h][i]] = label; }
+            m_size[label] += static_cast<int>(m_queue[h].size());
+        }
+    }
+}
+
+/// ラベルの代表取得 経路を縮める
+int HexComponentMap::findCompress(int label)
+{
+    const int root = find(label);
+    while (m_parent[label] != root) {
+        const int next = m_parent[label];
+        m_parent[label] = root;
+        label = next;
+    }
+    return root;
+}
+
+/// 新しいラベルを作る
+int HexComponentMap::newLabel()
+{
+    const int label = static_cast<int>(m_parent.size());
+    m_parent.push_back(label);
+    m_size.push_back(1);
+    return label;
+}
+
+/// 二つのラベルを併合する
+bool HexComponentMap::unite(int a, int b)
+{
+    a = findCompress(a);
+    b = findCompress(b);
+    if (a == b) { return false; }
+    if (m_size[a] < m_size[b]) { std::swap(a, b); }
+    m_parent[b] = a;
+    m_size[a] += m_size[b];
+    return true;
+}
@@ -0,0 +1,196 @@
+//
+//  HexComponentMap.h
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#ifndef Hex_HexComponentMap_h
+#define Hex_HexComponentMap_h
+
+#include "HexMap.h"
+#include "HexMoveCost.h"
+#include "HexPathFinder.h"
+
+#include <vector>
+
+/// @class 連結成分のラベル付け
+/// 侵入可能な位置を隣同士で繋いだ連結成分ごとにラベルを付け, 二点が互いに到達できるかを探索せずに答える
+/// 構築は行順に走査して先に走査した隣 (左, 左上, 右上) と併合するUnion-Findで, 位置の数に比例する
+/// 位置ごとにラベルを持ち, ラベル同士をUnion-Findで併合するので, 侵入可能になった位置は隣のラベルを併合するだけで済む
+/// 侵入不可になった位置は, 周りの侵入可能な隣が一続きならば分断されないことが分かるので何もしない
+/// そうでなければ各区間から同時に幅優先探索し, 出会わずに尽きた側だけを新しいラベルに付け替える
+class HexComponentMap
+{
+public:
+    /// 侵入不可の位置のラベル
+    static const int NoComponent = -1;
+
+    /// コンストラクタ
+    HexComponentMap();
+
+    /// 地形からラベルを付ける
+    /// 侵入不可の地形以外を侵入可能とみなす
+    /// @param map [in] ヘックスマップ
+    template <int Width, int Height>
+    void Build(const HexMap<HexChip, Width, Height>& map)
+    {
+        resize(map.GetWidth(), map.GetHeight());
+        for (int j(0); j < m_height; ++j) {
+            for (int i(0); i < m_width; ++i) {
+                const HexMapPosition pos(i, j);
+                if (map[pos] != HexChip::NoEntry) { join(pos); }
+            }
+        }
+        compact();
+    }
+
+    /// 移動コスト表で侵入可能な地形からラベルを付ける
+    /// @param map [in] ヘックスマップ
+    /// @param cost [in] 移動コスト表
+    template <int Width, int Height>
+    void Build(const HexMap<HexChip, Width, Height>& map, const HexMoveCost& cost)
+    {
+        resize(map.GetWidth(), map.GetHeight());
+        for (int j(0); j < m_height; ++j) {
+            for (int i(0); i < m_width; ++i) {
+                const HexMapPosition pos(i, j);
+                if (cost.IsPassable(map[pos].GetType())) { join(pos); }
+            }
+        }
+        compact();
+    }
+
+    /// 地形の変更を反映する
+    /// @param map [in] 地形を変更した後のヘックスマップ
+    /// @param pos [in] 地形を変更した位置
+    template <int Width, int Height>
+    void Update(const HexMap<HexChip, Width, Height>& map, const HexMapPosition& pos)
+    {
+        SetPassable(pos, map[pos] != HexChip::NoEntry);
+    }
+
+    /// 地形の変更を反映する
+    /// @param map [in] 地形を変更した後のヘックスマップ
+    /// @param cost [in] 構築に使った移動コスト表
+    /// @param pos [in] 地形を変更した位置
+    template <int Width, int Height>
+    void Update(const HexMap<HexChip, Width, Height>& map, const HexMoveCost& cost, const HexMapPosition& pos)
+    {
+        SetPassable(pos, cost.IsPassable(map[pos].GetType()));
+    }
+
+    /// 侵入可能であるか否かを変更する
+    /// @param pos [in] 位置
+    /// @param passable [in] 侵入可能ならばtrue
+    void SetPassable(const HexMapPosition& pos, bool passable);
+
+    /// 連結成分取得
+    /// @param pos [in] 位置
+    /// @retval 連結成分 同じ連結成分ならば同じ値 マップ外か侵入不可ならばNoComponent
+    int GetComponent(const HexMapPosition& pos) const
+    {
+        if (! contains(pos)) { return NoComponent; }
+        const int label = m_label[indexOf(pos)];
+        return (label < 0) ? NoComponent : find(label);
+    }
+
+    /// 同じ連結成分にあるか否か
+    /// 互いに到達できるならばtrue マップ外や侵入不可の位置を含めばfalse
+    /// @param a [in] 位置
+    /// @param b [in] 位置
+    bool SameComponent(const HexMapPosition& a, const HexMapPosition& b) const
+    {
+        const int component = GetComponent(a);
+        return (component != NoComponent) && (component == GetComponent(b));
+    }
+
+    /// 連結成分の数取得
+    int GetComponentCount() const { return m_count; }
+    /// 幅取得
+    int GetWidth() const { return m_width; }
+    /// 高さ取得
+    int GetHeight() const { return m_height; }
+
+private:
+    /// 大きさを変えて全位置を侵入不可にする
+    void resize(int width, int height);
+
+    /// 位置を侵入可能にし, 侵入可能な隣と併合する
+    void join(const HexMapPosition& pos);
+
+    /// ラベルを連結成分の代表に付け替え, 使わなくなったラベルを捨てる
+    void compact();
+
+    /// 侵入不可にした位置の周りが分断されていればラベルを付け替える
+    /// @param pos [in] 侵入不可にした位置
+    void split(const HexMapPosition& pos);
+
+    /// ラベルの代表取得
+    int find(int label) const
+    {
+        while (m_parent[label] != label) { label = m_parent[label]; }
+        return label;
+    }
+
+    /// ラベルの代表取得 経路を縮める
+    int findCompress(int label);
+
+    /// 新しいラベルを作る
+    int newLabel();
+
+    /// 二つのラベルを併合する
+    /// @retval 併合したならばtrue 既に同じならばfalse
+    bool unite(int a, int b);
+
+    /// マップ内であるか否か
+    bool contains(const HexMapPosition& pos) const
+    {
+        return (0 <= pos.X()) && (0 <= pos.Y()) && (pos.X() < m_width) && (pos.Y() < m_height);
+    }
+
+    /// 位置から添字を取得
+    int indexOf(const HexMapPosition& pos) const { return pos.X() + m_width * pos.Y(); }
+
+    int m_width;  /// 幅
+    int m_height; /// 高さ
+    int m_count;  /// 連結成分の数
+
+    std::vector<int> m_label;  /// 位置ごとのラベル 侵入不可ならばNoComponent
+    std::vector<int> m_parent; /// ラベルごとの親
+    std::vector<int> m_size;   /// 代表のラベルごとの大きさ 併合の向きを決める
+
+    /// 分断の探索の作業領域
+    /// 周りの侵入可能な隣は高々3区間に分かれる
+    enum { MaxArcCount = 3 };
+    std::vector<unsigned int> m_stamp;       /// 位置ごとの探索の世代
+    std::vector<int> m_group;                /// 位置ごとの探索した区間
+    std::vector<int> m_queue[MaxArcCount];   /// 区間ごとの探索した位置 先頭から順に広げる
+    unsigned int m_generation;               /// 探索の世代
+};
+
+/// 連結成分を確かめてから二点間の経路を探索する (A*)
+/// 到達できない組は探索せずに返す
+/// @param map [in] ヘックスマップ
+/// @param cost [in] 移動コスト表
+/// @param components [in] mapとcostから作った連結成分
+/// @param start [in] 開始地点
+/// @param goal [in] 目標地点
+/// @param path_map [out] 経路マップ 探索したときのみ書き込む
+/// @param distance_map [out] コストマップ 探索したときのみ書き込む
+/// @retval 目標地点までのコスト 到達できなければPathDistanceUnreachable
+template <int Width, int Height>
+int FindPath(const HexMap<HexChip, Width, Height>& map,
+             const HexMoveCost& cost,
+             const HexComponentMap& components,
+             const HexMapPosition& start,
+             const HexMapPosition& goal,
+             HexMap<HexMapPosition, Width, Height>& path_map,
+             HexMap<int, Width, Height>& distance_map)
+{
+    if (! components.SameComponent(start, goal)) { return PathDistanceUnreachable; }
+    return FindPath(map, cost, start, goal, path_map, distance_map);
+}
+
+#endif
@@ -0,0 +1,245 @@
+//
+//  HexDistanceOracle.cpp
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#include "HexDistanceOracle.h"
+
+#include <cstdio>
+#include <cstring>
+#include <stdint.h>
+
+#include <sys/stat.h>
+
+namespace {
+
+/// 事前計算表ファイルのヘッダ
+/// 後ろにランドマーク, 位置ごとの移動コスト, コスト表の順に並べる
+struct OracleFileHeader
+{
+    char     magic[8];       /// 識別子 "HEXORCL\0"
+    uint32_t byte_order;     /// バイト順判定 HexMapFileHeader::s_byte_order
+    uint32_t version;        /// 版
+    uint32_t mode;           /// 表の種類
+    int32_t  width;          /// 幅
+    int32_t  height;         /// 高さ
+    int32_t  landmark_count; /// ランドマーク数
+    uint64_t table_size;     /// コスト表の要素数
+    uint64_t checksum;       /// ヘッダより後ろのFNV-1a 64ビットハッシュ
+};
+
+const char     s_oracle_magic[8] = { 'H', 'E', 'X', 'O', 'R', 'C', 'L', '\0' };
+const uint32_t s_oracle_version  = 1;
+
+/// 位置ごとの要素のバイト数
+template <class T>
+std::size_t byteSize(const std::vector<T>& values) { return values.size() * sizeof(T); }
+
+/// 書き込む 空ならば何もしない
+template <class T>
+bool writeValues(FILE* fp, const std::vector<T>& values)
+{
+    return values.empty() || (std::fwrite(&values[0], byteSize(values), 1, fp) == 1);
+}
+
+/// 読み込む 空ならば何もしない
+template <class T>
+bool readValues(FILE* fp, std::vector<T>& values)
+{
+    return values.empty() || (std::fread(&values[0], byteSize(values), 1, fp) == 1);
+}
+
+/// チェックサムを続けて計算する
+template <class T>
+uint64_t continueChecksum(uint64_t hash, const std::vector<T>& values)
+{
+    return values.empty() ? hash : ContinueHexMapFileChecksum(hash, &values[0], byteSize(values));
+}
+
+}
+
+const int HexDistanceOracle::AllPairsLimit;
+const long long HexDistanceOracle::s_far;
+
+/// コンストラクタ
+HexDistanceOracle::HexDistanceOracle()
+:m_mode(ModeEmpty)
+,m_width(0)
+,m_height(0)
+{}
+
+/// 全点対の表を引く
+int HexDistanceOracle::Lookup(const HexMapPosition& start, const HexMapPosition& goal) const
+{
+    if (m_mode != ModeAllPairs) { return PathDistanceUnreachable; }
+    if (! (contains(start) && contains(goal))) { return PathDistanceUnreachable; }
+
+    const int distance = m_table[static_cast<std::size_t>(indexOf(start)) * m_cell_cost.size() + indexOf(goal)];
+    return (distance < 0) ? PathDistanceUnreachable : distance;
+}
+
+/// コストの下界を取得
+int HexDistanceOracle::GetLowerBound(const HexMapPosition& start, const HexMapPosition& goal) const
+{
+    if (m_mode == ModeAllPairs) { return Lookup(start, goal); }
+    if (! (contains(start) && contains(goal))) { return PathDistanceUnreachable; }
+
+    const int bound = landmarkBound(indexOf(start), indexOf(goal));
+    return (bound < 0) ? PathDistanceUnreachable : bound;
+}
+
+/// コストの上界を取得
+int HexDistanceOracle::GetUpperBound(const HexMapPosition& start, const HexMapPosition& goal) const
+{
+    if (m_mode == ModeAllPairs) { return Lookup(start, goal); }
+    if (! (contains(start) && contains(goal))) { return PathDistanceUnreachable; }
+
+    const std::size_t size = m_cell_cost.size();
+    const int s = indexOf(start);
+    const int g = indexOf(goal);
+    int upper(PathDistanceUnreachable);
+    for (std::size_t l(0); l < m_landmarks.size(); ++l) {
+        const int* from = &m_table[l * size];
+        if ((from[s] < 0) || (from[g] < 0)) { continue; }
+        // start -> L は L -> start を逆に辿ったもの
+        const int landmark = indexOf(m_landmarks[l]);
+        const int via = from[s] - m_cell_cost[s] + m_cell_cost[landmark] + from[g];
+        if ((upper < 0) || (via < upper)) { upper = via; }
+    }
+    return upper;
+}
+
+/// マップ内の侵入可能な位置であるか否か
+bool HexDistanceOracle::contains(const HexMapPosition& pos) const
+{
+    if (pos.X() < 0) { return false; }
+    if (pos.Y() < 0) { return false; }
+    if (m_width <= pos.X())  { return false; }
+    if (m_height <= pos.Y()) { return false; }
+
+    return 0 <= m_cell_cost[indexOf(pos)];
+}
+
+/// ランドマークによる下界
+int HexDistanceOracle::landmarkBound(int start, int goal) const
+{
+    const std::size_t size = m_cell_cost.size();
+    int bound(0);
+    for (std::size_t l(0); l < m_landmarks.size(); ++l) {
+        const int* from = &m_table[l * size];
+        const bool reach_start = (0 <= from[start]);
+        const bool reach_goal  = (0 <= from[goal]);
+        // 侵入可能な位置の連結は向きによらないので, 片方だけに届くならば別の領域にある
+        if (reach_start != reach_goal) { return -1; }
+        if (! reach_start) { continue; }
+
+        // d(L,goal) <= d(L,start) + d(start,goal)
+        const int forward = from[goal] - from[start];
+        // d(start,L) <= d(start,goal) + d(goal,L)
+        const int backward = (from[start] - m_cell_cost[start]) - (from[goal] - m_cell_cost[goal]);
+        if (bound < forward)  { bound = forward; }
+        if (bound < backward) { bound = backward; }
+    }
+    return bound;
+}
+
+/// ファイルに書き込む
+HexMapFileResult HexDistanceOracle::Save(const char* path) const
+{
+    OracleFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, s_oracle_magic, sizeof(header.magic));
+    header.byte_order     = HexMapFileHeader::s_byte_order;
+    header.version        = s_oracle_version;
+    header.mode           = m_mode;
+    header.width          = m_width;
+    header.height         = m_height;
+    header.landmark_count = GetLandmarkCount();
+    header.table_size     = m_table.size();
+    header.checksum       = continueChecksum(continueChecksum(continueChecksum(
+        CalcHexMapFileChecksum(NULL, 0), m_landmarks), m_cell_cost), m_table);
+
+    FILE* fp = std::fopen(path, "wb");
+    if (fp == NULL) { return HexMapFileOpenError; }
+
+    bool ok = (std::fwrite(&header, sizeof(header), 1, fp) == 1);
+    ok = ok && writeValues(fp, m_landmarks);
+    ok = ok && writeValues(fp, m_cell_cost);
+    ok = ok && writeValues(fp, m_table);
+    ok = (std::fclose(fp) == 0) && ok;
+    return ok ? HexMapFileOk : HexMapFileWriteError;
+}
+
+/// ファイルから読み込む
+HexMapFileResult HexDistanceOracle::Load(const char* path)
+{
+    *this = HexDistanceOracle();
+
+    FILE* fp = std::fopen(path, "rb");
+    if (fp == NULL) { return HexMapFileOpenError; }
+
+    OracleFileHeader header;
+    HexMapFileResult result(HexMapFileOk);
+    if (std::fread(&header, sizeof(header), 1, fp) != 1) { result = HexMapFileReadError; }
+    else if (std::memcmp(header.magic, s_oracle_magic, sizeof(header.magic)) != 0) { result = HexMapFileFormatError; }
+    else if (header.byte_order != HexMapFileHeader::s_byte_order) { result = HexMapFileFormatError; }
+    else if (header.version != s_oracle_version) { result = HexMapFileVersionError; }
+    else if ((header.mode != ModeAllPairs) && (header.mode != ModeLandmarks)) { result = HexMapFileFormatError; }
+    else if ((header.width < 0) || (header.height < 0) || (header.landmark_count < 0)) { result = HexMapFileFormatError; }
+
+    // 壊れたヘッダの大きさで確保しないよう, 先にファイルの長さを取る
+    struct stat st;
+    if ((result == HexMapFileOk) && (::fstat(::fileno(fp), &st) != 0)) { result = HexMapFileReadError; }
+    const uint64_t file_size = (result == HexMapFileOk) ? static_cast<uint64_t>(st.st_size) : 0;
+
+    // 表の大きさは種類と位置の数で決まる
+    const uint64_t cells = (result == HexMapFileOk) ? static_cast<uint64_t>(header.width) * static_cast<uint64_t>(header.height) : 0;
+    if (result == HexMapFileOk) {
+        const uint64_t rows = (header.mode == ModeAllPairs) ? cells : static_cast<uint64_t>(header.landmark_count);
+        if ((header.mode == ModeAllPairs) && ((AllPairsLimit < cells) || (header.landmark_count != 0))) { result = HexMapFileFormatError; }
+        // どの要素数もファイルに収まる範囲に抑えてから掛け合わせ, 桁あふれさせない
+        else if (file_size / sizeof(int) < cells) { result = HexMapFileFormatError; }
+        else if (file_size / sizeof(int) < header.table_size) { result = HexMapFileFormatError; }
+        else if (file_size / sizeof(HexMapPosition) < static_cast<uint64_t>(header.landmark_count)) { result = HexMapFileFormatError; }
+        else if ((cells == 0) ? (header.table_size != 0) : ((header.table_size % cells != 0) || (header.table_size / cells != rows))) { result = HexMapFileFormatError; }
+    }
+    if (result == HexMapFileOk) {
+        const uint64_t expected = sizeof(header)
+                                + static_cast<uint64_t>(header.landmark_count) * sizeof(HexMapPosition)
+                                + cells * sizeof(int)
+                                + header.table_size * sizeof(int);
+        if (expected != file_size) { result = HexMapFileFormatError; }
+    }
+
+    if (result == HexMapFileOk) {
+        m_landmarks.resize(header.landmark_count);
+        m_cell_cost.resize(static_cast<std::size_t>(cells));
+        m_table.resize(static_cast<std::size_t>(header.table_size));
+        const bool ok = readValues(fp, m_landmarks) && readValues(fp, m_cell_cost) && readValues(fp, m_table);
+        if (! ok) { result = HexMapFileReadError; }
+    }
+    std::fclose(fp);
+
+    if (result == HexMapFileOk) {
+        const uint64_t checksum = continueChecksum(continueChecksum(continueChecksum(
+            CalcHexMapFileChecksum(NULL, 0), m_landmarks), m_cell_cost), m_table);
+        if (checksum != header.checksum) { result = HexMapFileChecksumError; }
+    }
+    if (result == HexMapFileOk) {
+        m_width  = header.width;
+        m_height = header.height;
+        for (std::size_t l(0); l < m_landmarks.size(); ++l) {
+            if (! contains(m_landmarks[l])) { result = HexMapFileFormatError; }
+        }
+    }
+
+    if (result != HexMapFileOk) {
+        *this = HexDistanceOracle();
+        return result;
+    }
+    m_mode = static_cast<Mode>(header.mode);
+    return HexMapFileOk;
+}
@@ -0,0 +1,249 @@
+//
+//  HexDistanceOracle.h
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#ifndef Hex_HexDistanceOracle_h
+#define Hex_HexDistanceOracle_h
+
+#include "HexMap.h"
+#include "HexMapFile.h"
+#include "HexMoveCost.h"
+#include "HexPathFinder.h"
+#include "HexSearchContext.h"
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+/// @class 地形を考慮した二点間のコストの事前計算表
+/// 小さいマップでは全点対のコスト表を持ち, 問い合わせは表を引くだけで済む
+/// 大きいマップではランドマーク(ALT)を選んでランドマークからのコストを持ち,
+/// 三角不等式による下界を推定値とするA*で問い合わせる
+/// 移動コストは移動先の地形で決まるので向きによってコストが異なるが,
+/// 経路を逆に辿ると d(x,L) = d(L,x) - cost[x] + cost[L] となるので, ランドマークからの片道だけを持てばよい
+/// 構築に使ったマップと移動コスト表で問い合わせること
+class HexDistanceOracle
+{
+public:
+    /// 表の種類
+    enum Mode
+    {
+        ModeEmpty = 0, /// 未構築
+        ModeAllPairs,  /// 全点対
+        ModeLandmarks, /// ランドマーク
+    };
+
+    /// 全点対の表を作れる位置の数の上限 表は位置の数の二乗の大きさになる
+    static const int AllPairsLimit = 4096;
+
+    /// コンストラクタ
+    HexDistanceOracle();
+
+    /// 全点対のコスト表を構築する
+    /// 位置ごとにダイクストラ法で探索する
+    /// @param map [in] ヘックスマップ 位置の数はAllPairsLimit以下
+    /// @param cost [in] 移動コスト表
+    template <int Width, int Height>
+    void BuildAllPairs(const HexMap<HexChip, Width, Height>& map, const HexMoveCost& cost)
+    {
+        assert(map.Size() <= AllPairsLimit);
+        reset(ModeAllPairs, map, cost);
+
+        const int size = map.Size();
+        HexMap<HexMapPosition, Width, Height> path_map(map.GetWidth(), map.GetHeight());
+        HexMap<int, Width, Height>            distance_map(map.GetWidth(), map.GetHeight());
+        m_table.resize(static_cast<std::size_t>(size) * size);
+        for (int s(0); s < size; ++s) {
+            GenerateCostMap(map, cost, positionOf(s), path_map, distance_map);
+            std::copy(distance_map.begin(), distance_map.end(), m_table.begin() + static_cast<std::size_t>(s) * size);
+        }
+    }
+
+    /// ランドマークのコスト表を構築する
+    /// 最初のランドマークは最初の侵入可能な位置から最も遠い位置, 以降は既存のランドマークから最も遠い位置を選ぶ
+    /// 到達できない位置は最も遠いとみなすので, 連結していない領域にもランドマークが置かれる
+    /// @param map [in] ヘックスマップ
+    /// @param cost [in] 移動コスト表
+    /// @param landmark_count [in] ランドマークの数 侵入可能な位置が足りなければ少なくなる
+    template <int Width, int Height>
+    void BuildLandmarks(const HexMap<HexChip, Width, Height>& map, const HexMoveCost& cost, int landmark_count)
+    {
+        reset(ModeLandmarks, map, cost);
+
+        const int size = map.Size();
+        HexMap<HexMapPosition, Width, Height> path_map(map.GetWidth(), map.GetHeight());
+        HexMap<int, Width, Height>            distance_map(map.GetWidth(), map.GetHeight());
+
+        int seed(-1);
+        for (int i(0); (i < size) && (seed < 0); ++i) {
+            if (0 <= m_cell_cost[i]) { seed = i; }
+        }
+        if (seed < 0) { return; }
+
+        // 各位置から最も近いランドマークまでのコスト 最初だけは開始地点からのコスト
+        std::vector<long long> nearest(size, s_far);
+        GenerateCostMap(map, cost, positionOf(seed), path_map, distance_map);
+        updateNearest(distance_map.begin(), nearest);
+
+        for (int l(0); l < landmark_count; ++l) {
+            int farthest(-1);
+            for (int i(0); i < size; ++i) {
+                if (m_cell_cost[i] < 0) { continue; }
+                if ((farthest < 0) || (nearest[farthest] < nearest[i])) { farthest = i; }
+            }
+            // すべての侵入可能な位置がランドマークになった
+            if (nearest[farthest] == 0) { break; }
+
+            GenerateCostMap(map, cost, positionOf(farthest), path_map, distance_map);
+            m_landmarks.push_back(positionOf(farthest));
+            m_table.insert(m_table.end(), distance_map.begin(), distance_map.end());
+            if (l == 0) { std::fill(nearest.begin(), nearest.end(), s_far); }
+            updateNearest(distance_map.begin(), nearest);
+        }
+    }
+
+    /// 二点間のコストを問い合わせる
+    /// 全点対ならば表を引く ランドマークならば下界を推定値とするA*で探索する
+    /// 探索は作業領域の上で行うので, 触れた範囲にだけ書き込み, 二回目以降はメモリを確保しない
+    /// @param map [in] 構築に使ったヘックスマップ
+    /// @param cost [in] 構築に使った移動コスト表
+    /// @param start [in] 開始地点
+    /// @param goal [in] 目標地点
+    /// @param context [in,out] 作業領域 ランドマークの場合のみ探索し, 経路はGetPath()で取り出す
+    /// @retval コスト 到達できなければPathDistanceUnreachable
+    template <int Width, int Height>
+    int Query(const HexMap<HexChip, Width, Height>& map,
+              const HexMoveCost& cost,
+              const HexMapPosition& start,
+              const HexMapPosition& goal,
+              HexSearchContext& context) const
+    {
+        assert((map.GetWidth() == m_width) && (map.GetHeight() == m_height));
+        if (m_mode == ModeAllPairs) { return Lookup(start, goal); }
+        if (! (contains(start) && contains(goal))) { return PathDistanceUnreachable; }
+        if (GetLowerBound(start, goal) == PathDistanceUnreachable) { return PathDistanceUnreachable; }
+        return context.Search(map, cost, start, &goal, Heuristic(*this, goal));
+    }
+
+    /// 全点対の表を引く
+    /// @param start [in] 開始地点
+    /// @param goal [in] 目標地点
+    /// @retval コスト 到達できないか全点対でなければPathDistanceUnreachable
+    int Lookup(const HexMapPosition& start, const HexMapPosition& goal) const;
+
+    /// コストの下界を取得
+    /// 全点対ならば正確なコスト ランドマークならば三角不等式による下界
+    /// @param start [in] 開始地点
+    /// @param goal [in] 目標地点
+    /// @retval 下界 到達できないことが分かればPathDistanceUnreachable
+    int GetLowerBound(const HexMapPosition& start, const HexMapPosition& goal) const;
+
+    /// コストの上界を取得
+    /// ランドマークを経由する経路のうち最も安いもののコスト
+    /// @param start [in] 開始地点
+    /// @param goal [in] 目標地点
+    /// @retval 上界 どのランドマークを経由しても到達できなければPathDistanceUnreachable
+    int GetUpperBound(const HexMapPosition& start, const HexMapPosition& goal) const;
+
+    /// 表の種類取得
+    Mode GetMode() const { return m_mode; }
+    /// ランドマーク数取得
+    int GetLandmarkCount() const { return static_cast<int>(m_landmarks.size()); }
+    /// ランドマーク取得
+    const HexMapPosition& GetLandmark(int index) const { return m_landmarks[index]; }
+    /// 幅取得
+    int GetWidth() const { return m_width; }
+    /// 高さ取得
+    int GetHeight() const { return m_height; }
+
+    /// ファイルに書き込む
+    /// @param path [in] ファイルパス
+    /// @retval 結果
+    HexMapFileResult Save(const char* path) const;
+
+    /// ファイルから読み込む
+    /// ヘッダの大きさとファイルの長さが一致することを確かめてから領域を確保する
+    /// チェックサムを確かめ, 失敗したら未構築に戻る
+    /// @param path [in] ファイルパス
+    /// @retval 結果
+    HexMapFileResult Load(const char* path);
+
+private:
+    /// ランドマークによる推定値
+    /// 各ランドマークLについて d(L,goal) - d(L,x) と d(x,L) - d(goal,L) の最大値を取る
+    /// どちらも三角不等式による下界で, 無矛盾な推定値になる
+    class Heuristic
+    {
+    public:
+        Heuristic(const HexDistanceOracle& oracle, const HexMapPosition& goal)
+        :m_oracle(oracle)
+        ,m_goal(oracle.indexOf(goal))
+        {}
+
+        int operator()(const HexMapPosition& pos) const
+        {
+            const int bound = m_oracle.landmarkBound(m_oracle.indexOf(pos), m_goal);
+            return (bound < 0) ? 0 : bound;
+        }
+
+    private:
+        const HexDistanceOracle& m_oracle; /// 事前計算表
+        int m_goal;                        /// 目標地点の添字
+    };
+
+    /// 到達できない位置を最も遠いとみなすときのコスト
+    static const long long s_far = 1LL << 40;
+
+    /// 種類と大きさを設定し, 位置ごとの移動コストを記録する
+    template <int Width, int Height>
+    void reset(Mode mode, const HexMap<HexChip, Width, Height>& map, const HexMoveCost& cost)
+    {
+        m_mode   = mode;
+        m_width  = map.GetWidth();
+        m_height = map.GetHeight();
+        m_landmarks.clear();
+        m_table.clear();
+        m_cell_cost.resize(map.Size());
+        for (int i(0); i < map.Size(); ++i) { m_cell_cost[i] = cost(*(map.begin() + i)); }
+    }
+
+    /// 探索結果で各位置から最も近いランドマークまでのコストを更新する
+    /// @param distance [in] コストマップの先頭
+    /// @param nearest [in,out] 最も近いランドマークまでのコスト
+    template <class Iterator>
+    void updateNearest(Iterator distance, std::vector<long long>& nearest) const
+    {
+        for (std::size_t i(0); i < nearest.size(); ++i, ++distance) {
+            const long long reach = (*distance < 0) ? s_far : *distance;
+            if (reach < nearest[i]) { nearest[i] = reach; }
+        }
+    }
+
+    /// 位置から添字を取得
+    int indexOf(const HexMapPosition& pos) const { return pos.X() + m_width * pos.Y(); }
+    /// 添字から位置を取得
+    HexMapPosition positionOf(int index) const { return HexMapPosition(index % m_width, index / m_width); }
+    /// マップ内の侵入可能な位置であるか否か
+    bool contains(const HexMapPosition& pos) const;
+
+    /// ランドマークによる下界
+    /// @retval 下界 到達できないことが分かれば負
+    int landmarkBound(int start, int goal) const;
+
+    Mode m_mode;   /// 表の種類
+    int m_width;   /// 幅
+    int m_height;  /// 高さ
+
+    /// ランドマーク
+    std::vector<HexMapPosition> m_landmarks;
+    /// コスト表 全点対ならば [開始][目標] ランドマークならば [ランドマーク][位置]
+    std::vector<int> m_table;
+    /// 位置ごとの移動コスト 侵入不可ならば負
+    std::vector<int> m_cell_cost;
+};
+
+#endif
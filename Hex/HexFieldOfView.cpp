@@ -0,0 +1,180 @@
+//
+//  HexFieldOfView.cpp
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#include "HexFieldOfView.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace {
+
+/// 角度の比較の許容誤差
+const double s_epsilon = 1e-9;
+
+/// 環を一周する向き HexMapPosition::Neighbor順に辺を辿る
+/// 環の始まりはLeftの方向
+const HexMapPosition::Neighbor s_ring_start = HexMapPosition::Left;
+
+}
+
+/// コンストラクタ
+HexFieldOfView::HexFieldOfView()
+:m_shadows()
+{}
+
+/// 視界を計算する
+int HexFieldOfView::Compute(const HexMapView<HexChip>& map, const HexMapPosition& observer, int radius, HexBitMap& visible)
+{
+    assert((visible.GetWidth() == map.GetWidth()) && (visible.GetHeight() == map.GetHeight()));
+    m_shadows.clear();
+
+    const HexAxialPosition center = HexAxialPosition::FromOffset(observer);
+    int count(0);
+    if ((0 <= observer.X()) && (0 <= observer.Y()) && (observer.X() < map.GetWidth()) && (observer.Y() < map.GetHeight())) {
+        visible.Set(observer, true);
+        ++count;
+    }
+
+    for (int k(1); (k <= radius) && ! isFullyCovered(); ++k) {
+        const double width = 1.0 / (6 * k);
+        HexAxialPosition pos = center;
+        for (int i(0); i < k; ++i) { pos = pos.GetNeighbor(s_ring_start); }
+
+        int index(0);
+        for (int side(0); side < HexMapPosition::NeighborCount; ++side) {
+            for (int step(0); step < k; ++step, ++index) {
+                const HexMapPosition offset = pos.ToOffset();
+                pos = pos.GetNeighbor(static_cast<HexMapPosition::Neighbor>(side));
+
+                // マップ外は不透明とみなす
+                const bool opaque = ! IsEntriable(map, offset);
+                const double middle = index * width;
+                const double begin  = middle - width * 0.5;
+                const double end    = middle + width * 0.5;
+
+                const bool seen = opaque ? ! isCovered(begin, end) : ! isCovered(middle, middle);
+                if (seen && ! opaque) {
+                    visible.Set(offset, true);
+                    ++count;
+                }
+                if (seen && opaque) {
+                    if ((0 <= offset.X()) && (0 <= offset.Y()) && (offset.X() < map.GetWidth()) && (offset.Y() < map.GetHeight())) {
+                        visible.Set(offset, true);
+                        ++count;
+                    }
+                    addShadow(begin, end);
+                }
+            }
+        }
+    }
+    return count;
+}
+
+/// 角度の区間が影に覆われているか否か
+bool HexFieldOfView::isCovered(double begin, double end) const
+{
+    // 一周の境目をまたぐ区間は二つに分けて調べる
+    if (begin < 0.0) { return isCovered(begin + 1.0, 1.0) && isCovered(0.0, end); }
+
+    // 始まりが区間の始まり以前の最後の影だけが覆いうる
+    const Shadow key = { begin + s_epsilon, 0.0 };
+    std::vector<Shadow>::const_iterator it = std::upper_bound(m_shadows.begin(), m_shadows.end(), key, &HexFieldOfView::isBefore);
+    if (it == m_shadows.begin()) { return false; }
+    --it;
+    return end <= it->end + s_epsilon;
+}
+
+/// 角度の区間を影に加える
+void HexFieldOfView::addShadow(double begin, double end)
+{
+    if (begin < 0.0) {
+        addShadow(begin + 1.0, 1.0);
+        addShadow(0.0, end);
+        return;
+    }
+
+    // 重なるか接する影をまとめて一つにする
+    std::vector<Shadow>::iterator first = m_shadows.begin();
+    while ((first != m_shadows.end()) && (first->end + s_epsilon < begin)) { ++first; }
+    std::vector<Shadow>::iterator last = first;
+    while ((last != m_shadows.end()) && (last->begin <= end + s_epsilon)) {
+        begin = std::min(begin, last->begin);
+        end   = std::max(end, last->end);
+        ++last;
+    }
+    const Shadow shadow = { begin, end };
+    first = m_shadows.erase(first, last);
+    m_shadows.insert(first, shadow);
+}
+
+
+/// コンストラクタ
+HexFieldOfViewBatch::HexFieldOfViewBatch()
+:m_workers()
+{}
+
+/// 全観測者の視界を合わせて計算する
+void HexFieldOfViewBatch::Compute(HexPathExecutor& executor,
+                                  const HexMapView<HexChip>& map,
+                                  const HexMapPosition* observers,
+                                  int count,
+                                  int radius,
+                                  HexBitMap& visible)
+{
+    assert((visible.GetWidth() == map.GetWidth()) && (visible.GetHeight() == map.GetHeight()));
+    if (static_cast<int>(m_workers.size()) < executor.GetWorkerCount()) {
+        m_workers.resize(executor.GetWorkerCount());
+    }
+    for (std::size_t w(0); w < m_workers.size(); ++w) {
+        Worker& worker = m_workers[w];
+        if ((worker.visible.GetWidth() != map.GetWidth()) || (worker.visible.GetHeight() != map.GetHeight())) {
+            worker.visible.Resize(map.GetWidth(), map.GetHeight());
+        }
+        worker.first_row = map.GetHeight();
+        worker.last_row  = 0;
+    }
+
+    std::vector<Worker>& workers = m_workers;
+    const int height = map.GetHeight();
+    executor.ParallelFor(count, 16, [&](int begin, int end, int index) {
+        Worker& worker = workers[index];
+        for (int i(begin); i < end; ++i) {
+            worker.fov.Compute(map, observers[i], radius, worker.visible);
+            worker.first_row = std::min(worker.first_row, std::max(observers[i].Y() - radius, 0));
+            worker.last_row  = std::max(worker.last_row, std::min(observers[i].Y() + radius + 1, height));
+        }
+    });
+
+    // 行ごとに論理和を取り, 書き込んだ行だけを消す
+    const int word_count = visible.GetWordCount();
+    executor.ParallelFor(height, 16, [&](int begin, int end, int) {
+        for (std::size_t w(0); w < workers.size(); ++w) {
+            Worker& worker = workers[w];
+            for (int y(std::max(begin, worker.first_row)); y < std::min(end, worker.last_row); ++y) {
+                uint64_t* row = worker.visible.GetRow(y);
+                uint64_t* out = visible.GetRow(y);
+                for (int i(0); i < word_count; ++i) {
+                    out[i] |= row[i];
+                    row[i] = 0;
+                }
+            }
+        }
+    });
+}
+
+/// 全観測者の視界を合わせて計算する
+void HexFieldOfViewBatch::Compute(const HexMapView<HexChip>& map,
+                                  const HexMapPosition* observers,
+                                  int count,
+                                  int radius,
+                                  HexBitMap& visible)
+{
+    if (m_workers.empty()) { m_workers.resize(1); }
+    HexFieldOfView& fov = m_workers[0].fov;
+    for (int i(0); i < count; ++i) { fov.Compute(map, observers[i], radius, visible); }
+}
@@ -0,0 +1,151 @@
+//
+//  HexFieldOfView.h
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#ifndef Hex_HexFieldOfView_h
+#define Hex_HexFieldOfView_h
+
+#include "HexAxialPosition.h"
+#include "HexBitMap.h"
+#include "HexMapView.h"
+#include "HexPathExecutor.h"
+#include "HexRange.h"
+
+#include <vector>
+
+/// 二つの位置を結ぶ線分上のヘックスを列挙する
+/// HexLineCursorで辿る
+/// @tparam OutputIterator HexMapPositionを受け取る出力イテレータ
+/// @param a [in] 始点
+/// @param b [in] 終点
+/// @param out [out] 出力先 始点から終点まで距離+1個
+/// @retval 出力後の出力イテレータ
+template <class OutputIterator>
+OutputIterator HexLine(const HexMapPosition& a, const HexMapPosition& b, OutputIterator out)
+{
+    for (HexLineCursor cursor(HexAxialPosition::FromOffset(a), HexAxialPosition::FromOffset(b)); cursor.IsValid(); cursor.Next()) {
+        *out = cursor.Get();
+        ++out;
+    }
+    return out;
+}
+
+/// 二つの位置の間に視線が通るか否か
+/// 線分上の始点と終点を除くヘックスがすべてマップ内で, 侵入不可でなければ通る
+/// 終点が侵入不可でも, 手前が開けていれば見える
+/// @param map [in] ヘックスマップ参照
+/// @param a [in] 始点
+/// @param b [in] 終点
+/// @retval 視線が通ればtrue
+inline bool HasLineOfSight(const HexMapView<HexChip>& map, const HexMapPosition& a, const HexMapPosition& b)
+{
+    HexLineCursor cursor(HexAxialPosition::FromOffset(a), HexAxialPosition::FromOffset(b));
+    for (cursor.Next(); cursor.GetStep() < cursor.GetDistance(); cursor.Next()) {
+        if (! IsEntriable(map, cursor.Get())) { return false; }
+    }
+    return true;
+}
+
+
+/// @class 視界の計算 (シャドウキャスティング)
+/// 観測者を中心とする環を内側から順に調べ, 侵入不可の位置を不透明として背後に影を落とす
+/// 環上の位置は一周を環の位置の数で等分した角度の幅を持つとみなし, 影は角度の区間の集まりで表す
+/// 不透明でない位置は中心の角度が影に入っていなければ見え, 不透明な位置は幅の一部でも影から出ていれば見える
+/// 影が一周を覆ったらそれより外側は調べない
+/// 作業領域は使い回すので, 同じインスタンスを続けて使えばメモリを確保しない
+class HexFieldOfView
+{
+public:
+    /// コンストラクタ
+    HexFieldOfView();
+
+    /// 視界を計算する
+    /// 見える位置のビットを立てる 既に立っているビットは消さないので, 複数の観測者の視界を重ねられる
+    /// @param map [in] ヘックスマップ参照
+    /// @param observer [in] 観測者の位置
+    /// @param radius [in] 視界の半径
+    /// @param visible [in,out] 見える位置のビットを立てる マップと同じ大きさ
+    /// @retval 見えた位置の数 重なりも数える
+    int Compute(const HexMapView<HexChip>& map, const HexMapPosition& observer, int radius, HexBitMap& visible);
+
+private:
+    /// 影 一周を1とした角度の区間
+    struct Shadow
+    {
+        double begin; /// 始まり
+        double end;   /// 終わり
+    };
+
+    /// 始まりの順で前にあるか否か
+    static bool isBefore(const Shadow& a, const Shadow& b) { return a.begin < b.begin; }
+
+    /// 角度の区間が影に覆われているか否か
+    bool isCovered(double begin, double end) const;
+
+    /// 角度の区間を影に加える
+    void addShadow(double begin, double end);
+
+    /// 一周を覆ったか否か
+    bool isFullyCovered() const
+    {
+        return (m_shadows.size() == 1) && (m_shadows[0].begin <= 0.0) && (1.0 <= m_shadows[0].end);
+    }
+
+    std::vector<Shadow> m_shadows; /// 重ならないよう併合し, 始まりの順に並べた影
+};
+
+
+/// @class 多数の観測者の視界をまとめて計算する
+/// 観測者をワーカーに振り分け, ワーカーごとのビットマップに書き込んでから行ごとに論理和を取る
+/// ワーカーごとの領域は使い回し, 書き込んだ行だけを消して合わせるので, 視界が狭ければマップの大きさによらない
+class HexFieldOfViewBatch
+{
+public:
+    /// コンストラクタ
+    HexFieldOfViewBatch();
+
+    /// 全観測者の視界を合わせて計算する
+    /// @param executor [in] 実行スレッドプール
+    /// @param map [in] ヘックスマップ参照
+    /// @param observers [in] 観測者の位置の配列
+    /// @param count [in] 観測者の数
+    /// @param radius [in] 視界の半径
+    /// @param visible [in,out] どれかの観測者から見える位置のビットを立てる マップと同じ大きさ
+    void Compute(HexPathExecutor& executor,
+                 const HexMapView<HexChip>& map,
+                 const HexMapPosition* observers,
+                 int count,
+                 int radius,
+                 HexBitMap& visible);
+
+    /// 全観測者の視界を合わせて計算する
+    /// 一つのスレッドで順に計算する
+    /// @param map [in] ヘックスマップ参照
+    /// @param observers [in] 観測者の位置の配列
+    /// @param count [in] 観測者の数
+    /// @param radius [in] 視界の半径
+    /// @param visible [in,out] どれかの観測者から見える位置のビットを立てる マップと同じ大きさ
+    void Compute(const HexMapView<HexChip>& map,
+                 const HexMapPosition* observers,
+                 int count,
+                 int radius,
+                 HexBitMap& visible);
+
+private:
+    /// ワーカーごとの作業領域
+    struct Worker
+    {
+        HexFieldOfView fov;  /// 視界の計算
+        HexBitMap visible;   /// 見える位置
+        int first_row;       /// 書き込んだ先頭の行
+        int last_row;        /// 書き込んだ終端の行
+    };
+
+    std::vector<Worker> m_workers; /// ワーカーごとの作業領域
+};
+
+#endif
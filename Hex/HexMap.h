@@ -10,15 +10,22 @@
 #define Hex_HexMap_h
 
 #include "HexMap.h"
+#include "HexBitMap.h"
 #include "HexChip.h"
 #include "HexMapPosition.h"
+#include "HexMapText.h"
+#include "HexPassableGrid.h"
 
-#include <sstream>
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <iterator>
 #include <vector>
+
 /// @class ヘックスマップ
 /// @tparam T ヘックスマップで保持する値
-/// @tparam Width 幅
-/// @tparam Height 高さ
+/// @tparam Width 幅 HexMapDynamicならば実行時に決める
+/// @tparam Height 高さ HexMapDynamicならば実行時に決める
 template <class T, int Width, int Height>
 class HexMap
 {
@@ -28,6 +35,18 @@ public:
     :m_hex(Width * Height)
     {}
     
+    /// コンストラクタ
+    /// 大きさを実行時に決めるマップと同じ書き方で生成するためのもの
+    /// @param width [in] 幅 Widthと一致すること
+    /// @param height [in] 高さ Heightと一致すること
+    HexMap(int width, int height)
+    :m_hex(Width * Height)
+    {
+        assert((width == Width) && (height == Height));
+        (void)width;
+        (void)height;
+    }
+    
     /// 要素アクセス
     inline       T& operator[](const HexMapPosition& pos)       { return At(pos); }
     inline const T& operator[](const HexMapPosition& pos) const { return At(pos); }
@@ -56,6 +75,88 @@ private:
     std::vector<T> m_hex;
 };
 
+/// @class 大きさを実行時に決めるヘックスマップ
+/// データファイルから読み込むマップなど, 大きさがコンパイル時に決まらない場合に使う
+/// @tparam T ヘックスマップで保持する値
+template <class T>
+class HexMap<T, HexMapDynamic, HexMapDynamic>
+{
+public:
+    /// コンストラクタ
+    HexMap()
+    :m_width(0)
+    ,m_height(0)
+    ,m_hex()
+    {}
+    
+    /// コンストラクタ
+    /// @param width [in] 幅
+    /// @param height [in] 高さ
+    HexMap(int width, int height)
+    :m_width(width)
+    ,m_height(height)
+    ,m_hex(width * height)
+    {
+        assert((0 <= width) && (0 <= height));
+    }
+    
+    /// 要素アクセス
+    inline       T& operator[](const HexMapPosition& pos)       { return At(pos); }
+    inline const T& operator[](const HexMapPosition& pos) const { return At(pos); }
+    
+    
+    /// 要素アクセス
+    inline       T& At(const HexMapPosition& pos)       { return m_hex[pos.X() + m_width * pos.Y()]; }
+    inline const T& At(const HexMapPosition& pos) const { return m_hex[pos.X() + m_width * pos.Y()]; }
+    
+    
+    /// 幅取得
+    inline int GetWidth()  const { return m_width; }
+    /// 高さ取得
+    inline int GetHeight() const { return m_height; }
+    /// 大きさ取得
+    inline int Size() const { return m_width * m_height; }
+    
+    /// 大きさ変更
+    /// 要素はすべて初期値に戻る
+    /// @param width [in] 幅
+    /// @param height [in] 高さ
+    void Resize(int width, int height)
+    {
+        assert((0 <= width) && (0 <= height));
+        m_width  = width;
+        m_height = height;
+        m_hex.assign(width * height, T());
+    }
+    
+    /// 要素の並びを入れ替える
+    /// 行順に並んだ要素を複製せずに引き取り, 元の要素を渡す
+    /// @param cells [in,out] 引き取る要素 width * height個であること 元の要素が入る
+    /// @param width [in] 幅
+    /// @param height [in] 高さ
+    void Swap(std::vector<T>& cells, int width, int height)
+    {
+        assert((0 <= width) && (0 <= height));
+        assert(cells.size() == static_cast<std::size_t>(width) * height);
+        m_hex.swap(cells);
+        m_width  = width;
+        m_height = height;
+    }
+    
+    typename std::vector<T>::iterator begin() { return m_hex.begin(); }
+    typename std::vector<T>::const_iterator begin() const { return m_hex.begin(); }
+    typename std::vector<T>::iterator end()   { return m_hex.end(); }
+    typename std::vector<T>::const_iterator end() const { return m_hex.end(); }
+    
+    
+private:
+    int m_width;  /// 幅
+    int m_height; /// 高さ
+    
+    /// マップ要素
+    std::vector<T> m_hex;
+};
+
 
 /// マップのその位置に侵入可能であるか否かを判定する
 /// @tparam マップ幅
@@ -73,85 +174,317 @@ bool IsEntriable(const HexMap<HexChip, Width, Height>& map, const HexMapPosition
 }
 
 /// ヘックスマップ出力オペレータの定義
+/// 行ごとにHexMapTextWriterで書き出す
 /// @tparam T 出力型
 /// @tparam Width マップ幅
 /// @tparam Height マップ高さ
 template <class T, int Width, int Height>
 std::ostream& operator<<(std::ostream& os, const HexMap<T, Width, Height>& hex_map)
 {
-    std::stringstream ss;
-    ss << hex_map[HexMapPosition(0,0)];
-    const int indent_size = ss.str().size() / 2 + 1;
-    for (int j(0); j <hex_map.GetHeight(); ++j) {
-        if (j % 2 == 1) {
-            for (int i(0); i < indent_size; ++i) { os << ' '; }
-        }
-        os << '|';
-        for (int i(0); i < hex_map.GetWidth(); ++i) {
-            os << hex_map[HexMapPosition(i, j)] << '|';
-        }
-        os << std::endl;
+    HexMapTextWriter writer(os);
+    for (int j(0); j < hex_map.GetHeight(); ++j) {
+        const typename std::vector<T>::const_iterator row = hex_map.begin() + hex_map.GetWidth() * j;
+        writer.WriteRow(row, row + hex_map.GetWidth());
     }
     return os;
 }
+
+/// テキストからヘックスマップを読み込む
+/// 出力オペレータの形式を一行ずつ読み, マップの大きさと一致することを確かめる
+/// @tparam T 要素型 HexMapTextCell<T>が必要
+/// @param is [in] 入力元
+/// @param hex_map [out] ヘックスマップ
+/// @retval 読み込めればtrue 形式か大きさが違うか, 最後の行の後ろに行が続けばfalse
+template <class T, int Width, int Height>
+bool ReadHexMap(std::istream& is, HexMap<T, Width, Height>& hex_map)
+{
+    HexMapTextReader<T> reader(is);
+    int count(0);
+    for (int j(0); j < hex_map.GetHeight(); ++j) {
+        const typename std::vector<T>::iterator row = hex_map.begin() + hex_map.GetWidth() * j;
+        if (reader.ReadRow(row, hex_map.GetWidth(), count) != HexMapTextReader<T>::RowRead) { return false; }
+        if (count != hex_map.GetWidth()) { return false; }
+    }
+    // 余分な行は上限0で読むので, マップには書き込まずに形式の違いになる
+    return reader.ReadRow(hex_map.begin(), 0, count) == HexMapTextReader<T>::EndOfInput;
+}
+
+/// テキストから大きさを実行時に決めるヘックスマップを読み込む
+/// 最初の行で幅を決め, 入力の終端までを読む
+/// 要素はマップ自身の領域を引き取って末尾に読み足すので, 一時的な複製を作らない
+/// 同じ大きさのマップを読み直すときなど, 元の領域が足りていれば読み込み中にメモリを確保しない
+/// @tparam T 要素型 HexMapTextCell<T>が必要
+/// @param is [in] 入力元
+/// @param hex_map [out] ヘックスマップ 読み込めなければ空になる
+/// @retval 読み込めればtrue 形式が違うか行の幅がそろわなければfalse
+template <class T>
+bool ReadHexMap(std::istream& is, HexMap<T, HexMapDynamic, HexMapDynamic>& hex_map)
+{
+    std::vector<T> cells;
+    hex_map.Swap(cells, 0, 0);
+    cells.clear();
     
+    HexMapTextReader<T> reader(is);
+    int width(-1);
+    int height(0);
+    for (;;) {
+        int count(0);
+        const typename HexMapTextReader<T>::Result result = reader.ReadRow(std::back_inserter(cells), (width < 0) ? INT_MAX : width, count);
+        if (result == HexMapTextReader<T>::EndOfInput) { break; }
+        if (result != HexMapTextReader<T>::RowRead) { return false; }
+        if (width < 0) { width = count; }
+        if (count != width) { return false; }
+        ++height;
+    }
     
-//// 経路マップを取得
-template <int Width, int Height>
-HexMap<HexMapPosition, Width, Height> GeneratePathMap(
-                                                      const HexMap<HexChip, Width, Height>& map,
-                                                      const HexMapPosition& start)
+    hex_map.Swap(cells, std::max(width, 0), height);
+    return true;
+}
+    
+    
+/// 経路探索の距離値
+enum PathDistance
 {
-   HexMap<int, Width, Height>          distance_map;
-   HexMap<HexMapPosition, Width, Height> path_map;
-        
-   std::fill(distance_map.begin(), distance_map.end(), -1);
-        
-   /// 開始地点設定
-   distance_map[start] = 0;
-   path_map[start]     = start;
+    PathDistanceUnreachable = -1, /// 到達不可能
+    PathDistanceNoEntry     = -2, /// 侵入不可
+};
+
+/// 幅優先探索の作業領域
+struct HexPathScratch
+{
+    std::vector<HexMapPosition> frontier; /// 待ち行列
+    HexPassableGrid             grid;     /// 番兵付きの侵入可否 訪問済みの位置は閉じる
+};
+
+/// 構築済みの侵入可否グリッドの上で, 複数の開始地点から経路マップと距離マップを生成する
+/// 全開始地点から同時に幅優先探索を行い, 各位置を一度だけ訪問する
+/// 移動は対称なので, 目標地点の集合を与えれば目標地点へ向かう経路の場にもなる
+/// @tparam InputIterator HexMapPositionを指す入力イテレータ
+/// @tparam PathMap HexMapPositionを保持するマップ
+/// @tparam DistanceMap intを保持するマップ
+/// @param first [in] 開始地点の先頭
+/// @param last [in] 開始地点の終端
+/// @param path_map [out] 経路マップ 各位置の一つ手前の位置 開始地点と到達できない位置は自身を指す
+/// @param distance_map [out] 最寄りの開始地点からの距離マップ 到達できない位置はPathDistanceUnreachable 侵入不可の位置はPathDistanceNoEntry
+/// @param scratch [in,out] 作業領域 gridは経路マップと同じ大きさで構築しておくこと 訪問した位置は閉じる
+/// @retval 到達できた位置の数
+template <class InputIterator, class PathMap, class DistanceMap>
+int GeneratePathMapOnGrid(InputIterator first,
+                          InputIterator last,
+                          PathMap& path_map,
+                          DistanceMap& distance_map,
+                          HexPathScratch& scratch)
+{
+    HexPassableGrid& grid = scratch.grid;
+    assert((path_map.GetWidth() == grid.GetWidth()) && (path_map.GetHeight() == grid.GetHeight()));
+    assert((distance_map.GetWidth() == grid.GetWidth()) && (distance_map.GetHeight() == grid.GetHeight()));
+    
+    for (int j(0); j < grid.GetHeight(); ++j) {
+        for (int i(0); i < grid.GetWidth(); ++i) {
+            const HexMapPosition pos(i, j);
+            path_map[pos]     = pos;
+            distance_map[pos] = grid.IsEntriable(pos) ? PathDistanceUnreachable : PathDistanceNoEntry;
+        }
+    }
+    
+    /// 各位置は一度しか積まれないので, 配列をそのまま待ち行列として使う
+    std::vector<HexMapPosition>& frontier = scratch.frontier;
+    frontier.clear();
+    frontier.reserve(grid.GetWidth() * grid.GetHeight());
+    
+    /// 開始地点設定
+    for (; first != last; ++first) {
+        const HexMapPosition start = *first;
+        if ((start.X() < 0) || (grid.GetWidth() <= start.X()))  { continue; }
+        if ((start.Y() < 0) || (grid.GetHeight() <= start.Y())) { continue; }
+        const int index = grid.IndexOf(start);
+        if (! grid.IsEntriable(index)) { continue; }
+        grid.Close(index);
+        distance_map[start] = 0;
+        frontier.push_back(start);
+    }
+    
+    /// 侵入可否は番兵付きのグリッドで引き, 訪問した位置はグリッド上で閉じる
+    for (std::size_t head(0); head < frontier.size(); ++head) {
+        const HexMapPosition pivot = frontier[head];
+        const int index  = grid.IndexOf(pivot);
+        const int* delta = grid.GetNeighborDelta(pivot.Y());
+        const int next   = distance_map[pivot] + 1;
         
-   while (std::find(distance_map.begin(), distance_map.end(), -1) != distance_map.end()) {
-        for (HexMapPositionIterator<Width, Height> itr = HexMapPositionIterator<Width, Height>::begin();
-                 itr != HexMapPositionIterator<Width, Height>::end();
-                 ++itr) {
-            const HexMapPosition pipot = *itr;
-                
-            if (map[pipot] == HexChip::NoEntry) {
-                distance_map[pipot] = -2;
-                path_map[pipot] = pipot;
-                continue;
-            }
-            register const int current = distance_map.At(pipot);
-            if (current == -1) { continue; }
-            
-            for (int i(0); i < HexMapPosition::NeighborCount; ++i) {
-                const HexMapPosition candidate = pipot.GetNeighbor(static_cast<HexMapPosition::Neighbor>(i));
-                if (! IsEntriable(map, candidate)) { continue; }
+        for (int i(0); i < HexMapPosition::NeighborCount; ++i) {
+            const int candidate_index = index + delta[i];
+            if (! grid.IsEntriable(candidate_index)) { continue; }
+            grid.Close(candidate_index);
             
-                if ((distance_map[candidate] != -1) && (distance_map[candidate] < current + 1)) {
-                    continue;
-                }
-                distance_map[candidate] = current + 1;
-                path_map[candidate]     = pipot;
-            }
+            const HexMapPosition candidate = pivot.GetNeighbor(static_cast<HexMapPosition::Neighbor>(i));
+            distance_map[candidate] = next;
+            path_map[candidate]     = pivot;
+            frontier.push_back(candidate);
         }
     }
-        
+    return static_cast<int>(frontier.size());
+}
+
+/// 複数の開始地点から経路マップと距離マップを生成する
+/// @tparam InputIterator HexMapPositionを指す入力イテレータ
+/// @param map [in] ヘックスマップ
+/// @param first [in] 開始地点の先頭
+/// @param last [in] 開始地点の終端
+/// @param path_map [out] 経路マップ 各位置の一つ手前の位置 開始地点と到達できない位置は自身を指す
+/// @param distance_map [out] 最寄りの開始地点からの距離マップ 到達できない位置はPathDistanceUnreachable 侵入不可の位置はPathDistanceNoEntry
+/// @param scratch [in,out] 作業領域 確保済みの領域を使い回す
+/// @retval 到達できた位置の数
+template <int Width, int Height, class InputIterator>
+int GeneratePathMap(const HexMap<HexChip, Width, Height>& map,
+                    InputIterator first,
+                    InputIterator last,
+                    HexMap<HexMapPosition, Width, Height>& path_map,
+                    HexMap<int, Width, Height>& distance_map,
+                    HexPathScratch& scratch)
+{
+    scratch.grid.Build(map);
+    return GeneratePathMapOnGrid(first, last, path_map, distance_map, scratch);
+}
+
+/// 侵入可否の層から, 複数の開始地点の経路マップと距離マップを生成する
+/// 地形を詰めて持つ大きなマップなど, HexChipのマップを持たない場合に使う
+/// @tparam InputIterator HexMapPositionを指す入力イテレータ
+/// @param passable [in] 侵入可能な位置のビットが立った層
+/// @param first [in] 開始地点の先頭
+/// @param last [in] 開始地点の終端
+/// @param path_map [out] 経路マップ 各位置の一つ手前の位置 開始地点と到達できない位置は自身を指す
+/// @param distance_map [out] 最寄りの開始地点からの距離マップ 到達できない位置はPathDistanceUnreachable 侵入不可の位置はPathDistanceNoEntry
+/// @param scratch [in,out] 作業領域 確保済みの領域を使い回す
+/// @retval 到達できた位置の数
+template <int Width, int Height, class InputIterator>
+int GeneratePathMap(const HexBitMap& passable,
+                    InputIterator first,
+                    InputIterator last,
+                    HexMap<HexMapPosition, Width, Height>& path_map,
+                    HexMap<int, Width, Height>& distance_map,
+                    HexPathScratch& scratch)
+{
+    scratch.grid.Build(passable);
+    return GeneratePathMapOnGrid(first, last, path_map, distance_map, scratch);
+}
+
+/// 複数の開始地点から経路マップと距離マップを生成する
+/// @tparam InputIterator HexMapPositionを指す入力イテレータ
+/// @param map [in] ヘックスマップ
+/// @param first [in] 開始地点の先頭
+/// @param last [in] 開始地点の終端
+/// @param path_map [out] 経路マップ 各位置の一つ手前の位置 開始地点と到達できない位置は自身を指す
+/// @param distance_map [out] 最寄りの開始地点からの距離マップ
+/// @retval 到達できた位置の数
+template <int Width, int Height, class InputIterator>
+int GeneratePathMap(const HexMap<HexChip, Width, Height>& map,
+                    InputIterator first,
+                    InputIterator last,
+                    HexMap<HexMapPosition, Width, Height>& path_map,
+                    HexMap<int, Width, Height>& distance_map)
+{
+    HexPathScratch scratch;
+    return GeneratePathMap(map, first, last, path_map, distance_map, scratch);
+}
+
+/// 経路マップと距離マップを生成する
+/// 開始地点からの幅優先探索で各位置を一度だけ訪問する
+/// @param map [in] ヘックスマップ
+/// @param start [in] 開始地点
+/// @param path_map [out] 経路マップ 各位置の一つ手前の位置 到達できない位置は自身を指す
+/// @param distance_map [out] 距離マップ 到達できない位置はPathDistanceUnreachable 侵入不可の位置はPathDistanceNoEntry
+/// @retval 到達できた位置の数
+template <int Width, int Height>
+int GeneratePathMap(const HexMap<HexChip, Width, Height>& map,
+                    const HexMapPosition& start,
+                    HexMap<HexMapPosition, Width, Height>& path_map,
+                    HexMap<int, Width, Height>& distance_map)
+{
+    return GeneratePathMap(map, &start, &start + 1, path_map, distance_map);
+}
+
+/// 侵入可否の層から経路マップと距離マップを生成する
+/// @param passable [in] 侵入可能な位置のビットが立った層
+/// @param start [in] 開始地点
+/// @param path_map [out] 経路マップ 各位置の一つ手前の位置 到達できない位置は自身を指す
+/// @param distance_map [out] 距離マップ 到達できない位置はPathDistanceUnreachable 侵入不可の位置はPathDistanceNoEntry
+/// @retval 到達できた位置の数
+template <int Width, int Height>
+int GeneratePathMap(const HexBitMap& passable,
+                    const HexMapPosition& start,
+                    HexMap<HexMapPosition, Width, Height>& path_map,
+                    HexMap<int, Width, Height>& distance_map)
+{
+    HexPathScratch scratch;
+    return GeneratePathMap(passable, &start, &start + 1, path_map, distance_map, scratch);
+}
+
+/// 経路マップを取得
+/// @param map [in] ヘックスマップ
+/// @param start [in] 開始地点
+/// @retval 経路マップ 到達できない位置は自身を指す
+template <int Width, int Height>
+HexMap<HexMapPosition, Width, Height> GeneratePathMap(const HexMap<HexChip, Width, Height>& map,
+                                                      const HexMapPosition& start)
+{
+    HexMap<int, Width, Height>            distance_map(map.GetWidth(), map.GetHeight());
+    HexMap<HexMapPosition, Width, Height> path_map(map.GetWidth(), map.GetHeight());
+    GeneratePathMap(map, start, path_map, distance_map);
     return path_map;
 }
 
 /// 経路の長さを取得
-template <int Width, int Height>
-int CalcPathLength(const HexMap<HexMapPosition, Width, Height>& map,
+/// 経路マップを終点から辿って数える 距離マップがあればそちらを引く方が速い
+/// @tparam PathMap HexMapPositionを保持するマップ HexMapやHexMapViewなど
+/// @param map [in] 経路マップ
+/// @param start [in] 開始地点
+/// @param end [in] 終点
+/// @retval 経路の長さ 到達できなければ-1
+template <class PathMap>
+int CalcPathLength(const PathMap& map,
                    const HexMapPosition& start,
                    const HexMapPosition& end)
 {
-    if (start == end) { return 0; }
-    if (map[end] == end) { return -1; }
-    return 1 + CalcPathLength(map, start, map[end]);
+    int length(0);
+    for (HexMapPosition pos = end; pos != start; pos = map[pos]) {
+        if (map[pos] == pos) { return -1; }
+        // 壊れた経路マップで無限に辿らないようにする
+        if (map.Size() <= length) { return -1; }
+        ++length;
+    }
+    return length;
 }
+
+/// 経路を復元する
+/// 再帰もメモリ確保も行わず, 呼び出し側が用意した領域に書き込む
+/// @tparam PathMap HexMapPositionを保持するマップ HexMapやHexMapViewなど
+/// @param map [in] 経路マップ
+/// @param start [in] 開始地点
+/// @param end [in] 終点
+/// @param buffer [out] 経路の格納先 開始地点から終点までを順に格納する
+/// @param capacity [in] 格納先の要素数
+/// @retval 経路の位置数(開始地点と終点を含む) 到達できなければ-1
+///         capacityより大きい場合はbufferに何も書き込まない
+template <class PathMap>
+int ReconstructPath(const PathMap& map,
+                    const HexMapPosition& start,
+                    const HexMapPosition& end,
+                    HexMapPosition* buffer,
+                    int capacity)
+{
+    const int length = CalcPathLength(map, start, end);
+    if (length < 0) { return -1; }
+    const int count = length + 1;
+    if (capacity < count) { return count; }
     
+    HexMapPosition pos = end;
+    for (int i(length); 0 <= i; --i) {
+        buffer[i] = pos;
+        pos = map[pos];
+    }
+    return count;
+}
+
 /// 距離を計算する関数オブジェクト
 template <int Width, int Height>
 struct CalcDistance : std::unary_function<const HexMapPosition, int>
@@ -0,0 +1,268 @@
+//
+//  HexMapFile.cpp
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#include "HexMapFile.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// 要素はファイルの領域をそのまま型として参照する
+static_assert(sizeof(HexChip) == 4, "HexChip must be stored as 4 bytes");
+static_assert(sizeof(HexMapPosition) == 8, "HexMapPosition must be stored as 8 bytes");
+static_assert(sizeof(HexMapFileHeader) == 64, "HexMapFileHeader must be 64 bytes");
+
+/// 識別子
+const char HexMapFileHeader::s_magic[8] = { 'H', 'E', 'X', 'M', 'A', 'P', '\0', '\0' };
+const uint32_t HexMapFileHeader::s_byte_order;
+const uint32_t HexMapFileHeader::s_version;
+const uint64_t HexMapFileHeader::s_alignment;
+
+namespace
+{
+
+/// 一行分の要素が範囲内か否か
+/// 地形は種類がHexChip::Count未満, 経路は位置がマップ内であること 距離は任意の値を許す
+/// @param header [in] ヘッダ 要素のバイト数は種類と一致していること
+/// @param row [in] 行の先頭
+bool isValidRow(const HexMapFileHeader& header, const unsigned char* row)
+{
+    // 列挙型として読むと範囲外の値を表せないので, 格納された整数として読む
+    const int32_t* values = reinterpret_cast<const int32_t*>(row);
+    switch (header.kind) {
+        case HexMapFileTerrain:
+            for (int i(0); i < header.width; ++i) {
+                if ((values[i] < 0) || (HexChip::Count <= values[i])) { return false; }
+            }
+            return true;
+        case HexMapFilePath:
+            for (int i(0); i < header.width; ++i) {
+                const int32_t x = values[i * 2];
+                const int32_t y = values[i * 2 + 1];
+                if ((x < 0) || (header.width <= x) || (y < 0) || (header.height <= y)) { return false; }
+            }
+            return true;
+        default:
+            return true;
+    }
+}
+
+/// 要素の種類に対する要素のバイト数
+/// @retval バイト数 種類が分からなければ0
+uint32_t elementSizeOf(uint32_t kind)
+{
+    switch (kind) {
+        case HexMapFileTerrain:  return sizeof(HexChip);
+        case HexMapFileDistance: return sizeof(int);
+        case HexMapFilePath:     return sizeof(HexMapPosition);
+        default:                 return 0;
+    }
+}
+
+/// 書き込み先と同じディレクトリに一時ファイルを作る
+/// 同じ名前を他の書き込みと取り合わないよう, プロセスIDと通し番号で名付けて排他的に作る
+/// @param path [in] 書き込み先のファイルパス
+/// @param temp_path [out] 作った一時ファイルのパス
+/// @retval 書き込み用に開いたファイル 作れなければNULL
+FILE* createTemporaryFile(const char* path, std::string& temp_path)
+{
+    static std::atomic<unsigned> s_serial(0);
+
+    for (int attempt(0); attempt < 16; ++attempt) {
+        char suffix[64];
+        std::snprintf(suffix, sizeof(suffix), ".tmp.%ld.%u", static_cast<long>(::getpid()), s_serial++);
+        temp_path = std::string(path) + suffix;
+
+        const int fd = ::open(temp_path.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0666);
+        if (fd < 0) {
+            if (errno == EEXIST) { continue; }
+            return NULL;
+        }
+        FILE* fp = ::fdopen(fd, "wb");
+        if (fp == NULL) {
+            ::close(fd);
+            ::unlink(temp_path.c_str());
+        }
+        return fp;
+    }
+    return NULL;
+}
+
+}
+
+/// 要素のチェックサムを計算する
+uint64_t CalcHexMapFileChecksum(const void* data, std::size_t size)
+{
+    return ContinueHexMapFileChecksum(UINT64_C(14695981039346656037), data, size);
+}
+
+/// チェックサムを続けて計算する
+uint64_t ContinueHexMapFileChecksum(uint64_t hash, const void* data, std::size_t size)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i(0); i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= UINT64_C(1099511628211);
+    }
+    return hash;
+}
+
+/// マップファイルを書き込む
+HexMapFileResult WriteHexMapFile(const char* path,
+                                 HexMapFileKind kind,
+                                 uint32_t element_size,
+                                 int width,
+                                 int height,
+                                 const void* data,
+                                 std::size_t row_stride)
+{
+    const std::size_t row_size = static_cast<std::size_t>(element_size) * width;
+    if (row_stride == 0) { row_stride = row_size; }
+    const unsigned char* rows = static_cast<const unsigned char*>(data);
+
+    HexMapFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, HexMapFileHeader::s_magic, sizeof(header.magic));
+    header.byte_order   = HexMapFileHeader::s_byte_order;
+    header.version      = HexMapFileHeader::s_version;
+    header.kind         = kind;
+    header.element_size = element_size;
+    header.width        = width;
+    header.height       = height;
+    header.data_offset  = HexMapFileHeader::s_alignment;
+    header.data_size    = static_cast<uint64_t>(element_size) * width * height;
+    header.checksum     = CalcHexMapFileChecksum(NULL, 0);
+    for (int j(0); j < height; ++j) {
+        header.checksum = ContinueHexMapFileChecksum(header.checksum, rows + row_stride * j, row_size);
+    }
+
+    // 開いている読み手の領域を書き換えないよう, 一時ファイルに書き切ってから置き換える
+    std::string temp_path;
+    FILE* fp = createTemporaryFile(path, temp_path);
+    if (fp == NULL) { return HexMapFileOpenError; }
+
+    // ヘッダの後ろは要素の先頭まで0で埋める
+    const char padding[HexMapFileHeader::s_alignment] = {};
+    const std::size_t padding_size = static_cast<std::size_t>(header.data_offset) - sizeof(header);
+    bool ok = (std::fwrite(&header, sizeof(header), 1, fp) == 1);
+    if (0 < padding_size) {
+        ok = ok && (std::fwrite(padding, padding_size, 1, fp) == 1);
+    }
+    if (row_stride == row_size) {
+        // 隙間なく並んでいれば一度に書き込む
+        if (0 < header.data_size) {
+            ok = ok && (std::fwrite(data, static_cast<std::size_t>(header.data_size), 1, fp) == 1);
+        }
+    } else {
+        for (int j(0); (j < height) && (0 < row_size); ++j) {
+            ok = ok && (std::fwrite(rows + row_stride * j, row_size, 1, fp) == 1);
+        }
+    }
+    ok = ok && (std::fflush(fp) == 0) && (::fsync(::fileno(fp)) == 0);
+    ok = (std::fclose(fp) == 0) && ok;
+    ok = ok && (std::rename(temp_path.c_str(), path) == 0);
+    if (! ok) {
+        ::unlink(temp_path.c_str());
+        return HexMapFileWriteError;
+    }
+    return HexMapFileOk;
+}
+
+/// コンストラクタ
+HexMapFile::HexMapFile()
+:m_address(NULL)
+,m_size(0)
+{}
+
+/// デストラクタ
+HexMapFile::~HexMapFile()
+{
+    Close();
+}
+
+/// 開く
+HexMapFileResult HexMapFile::Open(const char* path, unsigned verify)
+{
+    Close();
+
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0) { return HexMapFileOpenError; }
+
+    struct stat st;
+    if ((::fstat(fd, &st) != 0) || (st.st_size < static_cast<off_t>(sizeof(HexMapFileHeader)))) {
+        ::close(fd);
+        return HexMapFileFormatError;
+    }
+
+    void* address = ::mmap(NULL, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    // 割り当てた後は記述子がなくても参照できる
+    ::close(fd);
+    if (address == MAP_FAILED) { return HexMapFileReadError; }
+
+    m_address = address;
+    m_size    = static_cast<std::size_t>(st.st_size);
+
+    const HexMapFileResult result = validate(verify);
+    if (result != HexMapFileOk) { Close(); }
+    return result;
+}
+
+/// 閉じる
+void HexMapFile::Close()
+{
+    if (m_address == NULL) { return; }
+    ::munmap(m_address, m_size);
+    m_address = NULL;
+    m_size    = 0;
+}
+
+/// ヘッダと大きさを検査し, 指定があれば要素を走査して検査する
+HexMapFileResult HexMapFile::validate(unsigned verify) const
+{
+    const HexMapFileHeader& header = GetHeader();
+    if (std::memcmp(header.magic, HexMapFileHeader::s_magic, sizeof(header.magic)) != 0) { return HexMapFileFormatError; }
+    if (header.byte_order != HexMapFileHeader::s_byte_order) { return HexMapFileFormatError; }
+    if (header.version != HexMapFileHeader::s_version) { return HexMapFileVersionError; }
+    if ((header.width < 0) || (header.height < 0)) { return HexMapFileFormatError; }
+    if (header.data_offset < sizeof(HexMapFileHeader)) { return HexMapFileFormatError; }
+    if (header.data_offset % HexMapFileHeader::s_alignment != 0) { return HexMapFileFormatError; }
+    // 壊れたヘッダで桁あふれしないよう, 掛け算ではなく割り算で確かめる
+    const uint64_t cells = static_cast<uint64_t>(header.width) * static_cast<uint64_t>(header.height);
+    if (cells == 0) {
+        if (header.data_size != 0) { return HexMapFileFormatError; }
+    } else {
+        if ((header.data_size % cells != 0) || (header.data_size / cells != header.element_size)) { return HexMapFileFormatError; }
+    }
+    if (m_size < header.data_offset) { return HexMapFileFormatError; }
+    if (m_size - header.data_offset < header.data_size) { return HexMapFileFormatError; }
+
+    const bool verify_checksum = (verify & HexMapFileVerifyChecksum) != 0;
+    const bool verify_elements = (verify & HexMapFileVerifyElements) != 0;
+    if (! (verify_checksum || verify_elements)) { return HexMapFileOk; }
+    // 要素を値として読むには, 要素のバイト数が種類どおりであること
+    if (verify_elements && (header.element_size != elementSizeOf(header.kind))) { return HexMapFileFormatError; }
+
+    // 行ごとにチェックサムを続けて計算し, 同じ行の要素を検査する
+    const unsigned char* data = static_cast<const unsigned char*>(m_address) + header.data_offset;
+    const std::size_t row_size = static_cast<std::size_t>(header.element_size) * header.width;
+    uint64_t checksum = CalcHexMapFileChecksum(NULL, 0);
+    for (int j(0); (j < header.height) && (0 < row_size); ++j) {
+        const unsigned char* row = data + row_size * j;
+        if (verify_checksum) { checksum = ContinueHexMapFileChecksum(checksum, row, row_size); }
+        if (verify_elements && (! isValidRow(header, row))) { return HexMapFileElementError; }
+    }
+    if (verify_checksum && (checksum != header.checksum)) { return HexMapFileChecksumError; }
+    return HexMapFileOk;
+}
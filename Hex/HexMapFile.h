@@ -0,0 +1,202 @@
+//
+//  HexMapFile.h
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#ifndef Hex_HexMapFile_h
+#define Hex_HexMapFile_h
+
+#include "HexChip.h"
+#include "HexMap.h"
+#include "HexMapPosition.h"
+#include "HexMapView.h"
+
+#include <cstddef>
+#include <stdint.h>
+
+/// マップファイルの要素の種類
+enum HexMapFileKind
+{
+    HexMapFileTerrain  = 1, /// 地形 HexChip
+    HexMapFileDistance = 2, /// 距離マップ int
+    HexMapFilePath     = 3, /// 経路マップ HexMapPosition
+};
+
+/// マップファイル操作の結果
+enum HexMapFileResult
+{
+    HexMapFileOk = 0,         /// 成功
+    HexMapFileOpenError,      /// 開けない
+    HexMapFileReadError,      /// 読めない
+    HexMapFileWriteError,     /// 書けない
+    HexMapFileFormatError,    /// 形式が違う
+    HexMapFileVersionError,   /// 版が違う
+    HexMapFileChecksumError,  /// チェックサムが合わない
+    HexMapFileElementError,   /// 要素の値が範囲外
+};
+
+/// マップファイルを開くときの検査
+/// 組み合わせるときは論理和を取る
+enum HexMapFileVerify
+{
+    HexMapFileVerifyNone     = 0,      /// ヘッダと大きさだけを検査する
+    HexMapFileVerifyChecksum = 1 << 0, /// 要素のチェックサムを確かめる
+    HexMapFileVerifyElements = 1 << 1, /// 地形の種類と経路の位置が範囲内か確かめる
+};
+
+/// マップファイルのヘッダ
+/// ファイルの先頭に置き, 要素はdata_offsetから行順に並べる
+/// 数値は書き込んだ環境のバイト順で, byte_orderで判定する
+struct HexMapFileHeader
+{
+    char     magic[8];     /// 識別子 "HEXMAP\0\0"
+    uint32_t byte_order;   /// バイト順判定 s_byte_order
+    uint32_t version;      /// 版 s_version
+    uint32_t kind;         /// 要素の種類 HexMapFileKind
+    uint32_t element_size; /// 要素のバイト数
+    int32_t  width;        /// 幅
+    int32_t  height;       /// 高さ
+    uint64_t data_offset;  /// 要素の先頭のファイル内位置
+    uint64_t data_size;    /// 要素のバイト数
+    uint64_t checksum;     /// 要素のFNV-1a 64ビットハッシュ
+    uint64_t reserved;     /// 予約 0
+
+    static const char     s_magic[8];
+    static const uint32_t s_byte_order = 0x01020304;
+    static const uint32_t s_version    = 1;
+    /// 要素の先頭の揃え
+    static const uint64_t s_alignment  = 64;
+};
+
+/// 要素の種類と大きさ
+template <class T> struct HexMapFileTraits;
+template <> struct HexMapFileTraits<HexChip>        { static const HexMapFileKind kind = HexMapFileTerrain; };
+template <> struct HexMapFileTraits<int>            { static const HexMapFileKind kind = HexMapFileDistance; };
+template <> struct HexMapFileTraits<HexMapPosition> { static const HexMapFileKind kind = HexMapFilePath; };
+
+/// 要素のチェックサムを計算する
+/// @param data [in] 要素の先頭
+/// @param size [in] バイト数
+/// @retval FNV-1a 64ビットハッシュ
+uint64_t CalcHexMapFileChecksum(const void* data, std::size_t size);
+
+/// チェックサムを続けて計算する
+/// 途中までのハッシュに続けて計算するので, 分かれた領域をまとめたチェックサムを求められる
+/// @param hash [in] 途中までのハッシュ 最初はCalcHexMapFileChecksum(NULL, 0)
+/// @param data [in] 続きの先頭
+/// @param size [in] バイト数
+/// @retval FNV-1a 64ビットハッシュ
+uint64_t ContinueHexMapFileChecksum(uint64_t hash, const void* data, std::size_t size);
+
+/// マップファイルを書き込む
+/// 同じディレクトリの一時ファイルに書き込んでから置き換えるので, 開いているHexMapFileは古い内容のまま読める
+/// 失敗したときは元のファイルを変えない
+/// @param path [in] ファイルパス
+/// @param kind [in] 要素の種類
+/// @param element_size [in] 要素のバイト数
+/// @param width [in] 幅
+/// @param height [in] 高さ
+/// @param data [in] 行順に並んだ要素の先頭
+/// @param row_stride [in] 行の先頭のバイト数の間隔 0ならば隙間なく並んでいる
+/// @retval 結果
+HexMapFileResult WriteHexMapFile(const char* path,
+                                 HexMapFileKind kind,
+                                 uint32_t element_size,
+                                 int width,
+                                 int height,
+                                 const void* data,
+                                 std::size_t row_stride = 0);
+
+/// ヘックスマップをファイルに書き込む
+/// @tparam T 要素型 HexChip, int, HexMapPositionのいずれか
+/// @param path [in] ファイルパス
+/// 切り出した参照は切り出した矩形だけを書き込む
+/// @param map [in] ヘックスマップ参照
+/// @retval 結果
+template <class T>
+HexMapFileResult SaveHexMap(const char* path, const HexMapView<T>& map)
+{
+    return WriteHexMapFile(path, HexMapFileTraits<T>::kind, sizeof(T), map.GetWidth(), map.GetHeight(), map.Data(),
+                           sizeof(T) * map.GetStride());
+}
+
+/// ヘックスマップをファイルに書き込む
+/// @param path [in] ファイルパス
+/// @param map [in] ヘックスマップ
+/// @retval 結果
+template <class T, int Width, int Height>
+HexMapFileResult SaveHexMap(const char* path, const HexMap<T, Width, Height>& map)
+{
+    return SaveHexMap(path, HexMapView<T>(map));
+}
+
+/// @class メモリに割り当てたマップファイル
+/// ファイルを読み取り専用でmmapし, 要素を複製も解析もせずに参照として渡す
+/// 割り当ては共有なので, 同じファイルを開いた他のプロセスとページを共有する
+/// 参照は閉じるまで使える
+/// 要素を検査せずに開いたときはファイルの内容を信用する 地形の種類や経路の位置が範囲外のファイルでは,
+/// 名前や移動コストを引いたり経路を辿ったりしたときに範囲外を読むので, 信用できないファイルは要素も検査すること
+class HexMapFile
+{
+public:
+    /// コンストラクタ
+    HexMapFile();
+
+    /// デストラクタ
+    /// 開いていれば閉じる
+    ~HexMapFile();
+
+    /// 開く
+    /// 開いていれば先に閉じる
+    /// チェックサムと要素の検査は同じ一回の走査で行う どちらも全ページを読むので起動が遅くなる
+    /// @param path [in] ファイルパス
+    /// @param verify [in] 検査 HexMapFileVerifyの論理和 trueはHexMapFileVerifyChecksumと同じ
+    /// @retval 結果 失敗したら閉じた状態になる
+    HexMapFileResult Open(const char* path, unsigned verify = HexMapFileVerifyNone);
+
+    /// 閉じる
+    void Close();
+
+    /// 開いているか否か
+    bool IsOpen() const { return m_address != NULL; }
+
+    /// ヘッダ取得
+    /// 開いていること
+    const HexMapFileHeader& GetHeader() const { return *static_cast<const HexMapFileHeader*>(m_address); }
+
+    /// 要素の種類が一致するか否か
+    /// @tparam T 要素型
+    template <class T>
+    bool Holds() const
+    {
+        return IsOpen() && (GetHeader().kind == static_cast<uint32_t>(HexMapFileTraits<T>::kind))
+            && (GetHeader().element_size == sizeof(T));
+    }
+
+    /// 要素の参照を取得
+    /// @tparam T 要素型
+    /// @retval 参照 要素の種類が違えば空の参照
+    template <class T>
+    HexMapView<T> GetView() const
+    {
+        if (! Holds<T>()) { return HexMapView<T>(); }
+        const char* data = static_cast<const char*>(m_address) + GetHeader().data_offset;
+        return HexMapView<T>(reinterpret_cast<const T*>(data), GetHeader().width, GetHeader().height);
+    }
+
+private:
+    /// コピー禁止
+    HexMapFile(const HexMapFile&);
+    HexMapFile& operator=(const HexMapFile&);
+
+    /// ヘッダと大きさを検査し, 指定があれば要素を走査して検査する
+    HexMapFileResult validate(unsigned verify) const;
+
+    void*       m_address; /// 割り当てた先頭
+    std::size_t m_size;    /// 割り当てたバイト数
+};
+
+#endif
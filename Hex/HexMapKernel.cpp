@@ -0,0 +1,534 @@
+//
+//  HexMapKernel.cpp
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#include "HexMapKernel.h"
+
+#include <climits>
+#include <cstring>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define HEX_KERNEL_X86 1
+#include <immintrin.h>
+#else
+#define HEX_KERNEL_X86 0
+#endif
+
+// ヘックスチップの並びを地形タイプの整数列として読む
+static_assert(sizeof(HexChip) == sizeof(int), "HexChip must be laid out as a single int");
+
+namespace {
+
+/// 命令セットごとの処理表
+struct KernelTable
+{
+    void (*build_passable_row)(const HexChip*, int, uint64_t*);
+    void (*relax_adjacent_row)(const uint64_t*, int, const uint64_t*, uint64_t*, uint64_t*, int);
+    void (*relax_same_row)(const uint64_t*, const uint64_t*, uint64_t*, uint64_t*, int);
+    void (*reduce_min_max)(const int*, int, int&, int&);
+    int  (*count_within)(const int*, int, int);
+    void (*build_within_row)(const int*, int, int, uint64_t*);
+};
+
+/// 語の前後を含めて前線を一つ左へずらす
+inline uint64_t shiftLeftward(const uint64_t* f, int i, int words)
+{
+    return (f[i] >> 1) | ((i + 1 < words) ? (f[i + 1] << 63) : 0);
+}
+
+/// 語の前後を含めて前線を一つ右へずらす
+inline uint64_t shiftRightward(const uint64_t* f, int i)
+{
+    return (f[i] << 1) | ((0 < i) ? (f[i - 1] >> 63) : 0);
+}
+
+/// 届いた位置を次の前線と訪問済みに加える
+inline void settle(uint64_t spread, const uint64_t* passable, uint64_t* visited, uint64_t* next, int i)
+{
+    const uint64_t reach = spread & passable[i] & ~visited[i];
+    next[i]    |= reach;
+    visited[i] |= reach;
+}
+
+/// 隣の行への一語分の広がり
+inline void relaxAdjacentWord(const uint64_t* frontier, int odd, const uint64_t* passable,
+                              uint64_t* visited, uint64_t* next, int words, int i)
+{
+    const uint64_t side = odd ? shiftRightward(frontier, i) : shiftLeftward(frontier, i, words);
+    settle(frontier[i] | side, passable, visited, next, i);
+}
+
+/// 同じ行への一語分の広がり
+inline void relaxSameWord(const uint64_t* frontier, const uint64_t* passable,
+                          uint64_t* visited, uint64_t* next, int words, int i)
+{
+    settle(shiftRightward(frontier, i) | shiftLeftward(frontier, i, words), passable, visited, next, i);
+}
+
+//------------------------------------------------------------------------------
+// 命令セット拡張なし
+
+void buildPassableRowScalar(const HexChip* chips, int width, uint64_t* bits)
+{
+    std::memset(bits, 0, sizeof(uint64_t) * HexKernelWordCount(width));
+    for (int i(0); i < width; ++i) {
+        if (chips[i] != HexChip::NoEntry) { bits[i / 64] |= uint64_t(1) << (i % 64); }
+    }
+}
+
+void relaxAdjacentRowScalar(const uint64_t* frontier, int source_y, const uint64_t* passable,
+                            uint64_t* visited, uint64_t* next, int words)
+{
+    const int odd = source_y & 1;
+    for (int i(0); i < words; ++i) {
+        relaxAdjacentWord(frontier, odd, passable, visited, next, words, i);
+    }
+}
+
+void relaxSameRowScalar(const uint64_t* frontier, const uint64_t* passable,
+                        uint64_t* visited, uint64_t* next, int words)
+{
+    for (int i(0); i < words; ++i) {
+        relaxSameWord(frontier, passable, visited, next, words, i);
+    }
+}
+
+void reduceMinMaxScalar(const int* values, int count, int& min_value, int& max_value)
+{
+    int lo(INT_MAX);
+    int hi(-1);
+    for (int i(0); i < count; ++i) {
+        const int v = values[i];
+        if (v < 0) { continue; }
+        lo = std::min(lo, v);
+        hi = std::max(hi, v);
+    }
+    min_value = (hi < 0) ? -1 : lo;
+    max_value = hi;
+}
+
+int countWithinScalar(const int* values, int count, int threshold)
+{
+    int result(0);
+    for (int i(0); i < count; ++i) {
+        if ((0 <= values[i]) && (values[i] <= threshold)) { ++result; }
+    }
+    return result;
+}
+
+void buildWithinRowScalar(const int* values, int width, int threshold, uint64_t* bits)
+{
+    std::memset(bits, 0, sizeof(uint64_t) * HexKernelWordCount(width));
+    for (int i(0); i < width; ++i) {
+        if ((0 <= values[i]) && (values[i] <= threshold)) { bits[i / 64] |= uint64_t(1) << (i % 64); }
+    }
+}
+
+const KernelTable s_scalar_table = {
+    buildPassableRowScalar,
+    relaxAdjacentRowScalar,
+    relaxSameRowScalar,
+    reduceMinMaxScalar,
+    countWithinScalar,
+    buildWithinRowScalar,
+};
+
+#if HEX_KERNEL_X86
+
+//------------------------------------------------------------------------------
+// SSE4.1
+
+__attribute__((target("sse4.1")))
+void buildPassableRowSse41(const HexChip* chips, int width, uint64_t* bits)
+{
+    const int* types = reinterpret_cast<const int*>(chips);
+    const __m128i no_entry = _mm_set1_epi32(HexChip::NoEntry);
+    std::memset(bits, 0, sizeof(uint64_t) * HexKernelWordCount(width));
+
+    int i(0);
+    for (; i + 4 <= width; i += 4) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(types + i));
+        const int blocked = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(v, no_entry)));
+        bits[i / 64] |= uint64_t(~blocked & 0xF) << (i % 64);
+    }
+    for (; i < width; ++i) {
+        if (types[i] != HexChip::NoEntry) { bits[i / 64] |= uint64_t(1) << (i % 64); }
+    }
+}
+
+/// 二語分の前線を広げて次の前線と訪問済みに加える
+__attribute__((target("sse4.1")))
+inline void settle2(__m128i spread, const uint64_t* passable, uint64_t* visited, uint64_t* next, int i)
+{
+    const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(passable + i));
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(visited + i));
+    const __m128i n = _mm_loadu_si128(reinterpret_cast<const __m128i*>(next + i));
+    const __m128i reach = _mm_andnot_si128(v, _mm_and_si128(spread, p));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(next + i), _mm_or_si128(n, reach));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(visited + i), _mm_or_si128(v, reach));
+}
+
+__attribute__((target("sse4.1")))
+void relaxAdjacentRowSse41(const uint64_t* frontier, int source_y, const uint64_t* passable,
+                           uint64_t* visited, uint64_t* next, int words)
+{
+    const int odd = source_y & 1;
+    // 前後の語を読むので両端の語は一語ずつ処理する
+    int i(0);
+    if (0 < words) { relaxAdjacentWord(frontier, odd, passable, visited, next, words, i++); }
+    for (; i + 3 <= words; i += 2) {
+        const __m128i f = _mm_loadu_si128(reinterpret_cast<const __m128i*>(frontier + i));
+        __m128i side;
+        if (odd) {
+            const __m128i prev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(frontier + i - 1));
+            side = _mm_or_si128(_mm_slli_epi64(f, 1), _mm_srli_epi64(prev, 63));
+        } else {
+            const __m128i post = _mm_loadu_si128(reinterpret_cast<const __m128i*>(frontier + i + 1));
+            side = _mm_or_si128(_mm_srli_epi64(f, 1), _mm_slli_epi64(post, 63));
+        }
+        settle2(_mm_or_si128(f, side), passable, visited, next, i);
+    }
+    for (; i < words; ++i) { relaxAdjacentWord(frontier, odd, passable, visited, next, words, i); }
+}
+
+__attribute__((target("sse4.1")))
+void relaxSameRowSse41(const uint64_t* frontier, const uint64_t* passable,
+                       uint64_t* visited, uint64_t* next, int words)
+{
+    int i(0);
+    if (0 < words) { relaxSameWord(frontier, passable, visited, next, words, i++); }
+    for (; i + 3 <= words; i += 2) {
+        const __m128i f    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(frontier + i));
+        const __m128i prev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(frontier + i - 1));
+        const __m128i post = _mm_loadu_si128(reinterpret_cast<const __m128i*>(frontier + i + 1));
+        const __m128i right = _mm_or_si128(_mm_slli_epi64(f, 1), _mm_srli_epi64(prev, 63));
+        const __m128i left  = _mm_or_si128(_mm_srli_epi64(f, 1), _mm_slli_epi64(post, 63));
+        settle2(_mm_or_si128(right, left), passable, visited, next, i);
+    }
+    for (; i < words; ++i) { relaxSameWord(frontier, passable, visited, next, words, i); }
+}
+
+__attribute__((target("sse4.1")))
+void reduceMinMaxSse41(const int* values, int count, int& min_value, int& max_value)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i large = _mm_set1_epi32(INT_MAX);
+    __m128i lo = large;
+    __m128i hi = _mm_set1_epi32(-1);
+
+    int i(0);
+    for (; i + 4 <= count; i += 4) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        // 負の値は最小値に影響しないよう最大の値に置き換える 最大値には元々影響しない
+        lo = _mm_min_epi32(lo, _mm_blendv_epi8(v, large, _mm_cmpgt_epi32(zero, v)));
+        hi = _mm_max_epi32(hi, v);
+    }
+    int lanes_lo[4];
+    int lanes_hi[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes_lo), lo);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes_hi), hi);
+
+    int rest_lo, rest_hi;
+    reduceMinMaxScalar(values + i, count - i, rest_lo, rest_hi);
+    int result_lo = (rest_hi < 0) ? INT_MAX : rest_lo;
+    int result_hi = rest_hi;
+    for (int k(0); k < 4; ++k) {
+        result_lo = std::min(result_lo, lanes_lo[k]);
+        result_hi = std::max(result_hi, lanes_hi[k]);
+    }
+    min_value = (result_hi < 0) ? -1 : result_lo;
+    max_value = result_hi;
+}
+
+__attribute__((target("sse4.1")))
+int countWithinSse41(const int* values, int count, int threshold)
+{
+    if (threshold == INT_MAX) { threshold = INT_MAX - 1; }
+    const __m128i below = _mm_set1_epi32(-1);
+    const __m128i above = _mm_set1_epi32(threshold + 1);
+
+    int result(0);
+    int i(0);
+    for (; i + 4 <= count; i += 4) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        const __m128i in = _mm_and_si128(_mm_cmpgt_epi32(v, below), _mm_cmpgt_epi32(above, v));
+        result += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(in)));
+    }
+    return result + countWithinScalar(values + i, count - i, threshold);
+}
+
+__attribute__((target("sse4.1")))
+void buildWithinRowSse41(const int* values, int width, int threshold, uint64_t* bits)
+{
+    if (threshold == INT_MAX) { threshold = INT_MAX - 1; }
+    const __m128i below = _mm_set1_epi32(-1);
+    const __m128i above = _mm_set1_epi32(threshold + 1);
+    std::memset(bits, 0, sizeof(uint64_t) * HexKernelWordCount(width));
+
+    int i(0);
+    for (; i + 4 <= width; i += 4) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        const __m128i in = _mm_and_si128(_mm_cmpgt_epi32(v, below), _mm_cmpgt_epi32(above, v));
+        bits[i / 64] |= uint64_t(_mm_movemask_ps(_mm_castsi128_ps(in))) << (i % 64);
+    }
+    for (; i < width; ++i) {
+        if ((0 <= values[i]) && (values[i] <= threshold)) { bits[i / 64] |= uint64_t(1) << (i % 64); }
+    }
+}
+
+const KernelTable s_sse41_table = {
+    buildPassableRowSse41,
+    relaxAdjacentRowSse41,
+    relaxSameRowSse41,
+    reduceMinMaxSse41,
+    countWithinSse41,
+    buildWithinRowSse41,
+};
+
+//------------------------------------------------------------------------------
+// AVX2
+
+__attribute__((target("avx2")))
+void buildPassableRowAvx2(const HexChip* chips, int width, uint64_t* bits)
+{
+    const int* types = reinterpret_cast<const int*>(chips);
+    const __m256i no_entry = _mm256_set1_epi32(HexChip::NoEntry);
+    std::memset(bits, 0, sizeof(uint64_t) * HexKernelWordCount(width));
+
+    int i(0);
+    for (; i + 8 <= width; i += 8) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(types + i));
+        const int blocked = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, no_entry)));
+        bits[i / 64] |= uint64_t(~blocked & 0xFF) << (i % 64);
+    }
+    for (; i < width; ++i) {
+        if (types[i] != HexChip::NoEntry) { bits[i / 64] |= uint64_t(1) << (i % 64); }
+    }
+}
+
+/// 四語分の前線を広げて次の前線と訪問済みに加える
+__attribute__((target("avx2")))
+inline void settle4(__m256i spread, const uint64_t* passable, uint64_t* visited, uint64_t* next, int i)
+{
+    const __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(passable + i));
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(visited + i));
+    const __m256i n = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(next + i));
+    const __m256i reach = _mm256_andnot_si256(v, _mm256_and_si256(spread, p));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(next + i), _mm256_or_si256(n, reach));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(visited + i), _mm256_or_si256(v, reach));
+}
+
+__attribute__((target("avx2")))
+void relaxAdjacentRowAvx2(const uint64_t* frontier, int source_y, const uint64_t* passable,
+                          uint64_t* visited, uint64_t* next, int words)
+{
+    const int odd = source_y & 1;
+    int i(0);
+    if (0 < words) { relaxAdjacentWord(frontier, odd, passable, visited, next, words, i++); }
+    for (; i + 5 <= words; i += 4) {
+        const __m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(frontier + i));
+        __m256i side;
+        if (odd) {
+            const __m256i prev = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(frontier + i - 1));
+            side = _mm256_or_si256(_mm256_slli_epi64(f, 1), _mm256_srli_epi64(prev, 63));
+        } else {
+            const __m256i post = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(frontier + i + 1));
+            side = _mm256_or_si256(_mm256_srli_epi64(f, 1), _mm256_slli_epi64(post, 63));
+        }
+        settle4(_mm256_or_si256(f, side), passable, visited, next, i);
+    }
+    for (; i < words; ++i) { relaxAdjacentWord(frontier, odd, passable, visited, next, words, i); }
+}
+
+__attribute__((target("avx2")))
+void relaxSameRowAvx2(const uint64_t* frontier, const uint64_t* passable,
+                      uint64_t* visited, uint64_t* next, int words)
+{
+    int i(0);
+    if (0 < words) { relaxSameWord(frontier, passable, visited, next, words, i++); }
+    for (; i + 5 <= words; i += 4) {
+        const __m256i f    = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(frontier + i));
+        const __m256i prev = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(frontier + i - 1));
+        const __m256i post = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(frontier + i + 1));
+        const __m256i right = _mm256_or_si256(_mm256_slli_epi64(f, 1), _mm256_srli_epi64(prev, 63));
+        const __m256i left  = _mm256_or_si256(_mm256_srli_epi64(f, 1), _mm256_slli_epi64(post, 63));
+        settle4(_mm256_or_si256(right, left), passable, visited, next, i);
+    }
+    for (; i < words; ++i) { relaxSameWord(frontier, passable, visited, next, words, i); }
+}
+
+__attribute__((target("avx2")))
+void reduceMinMaxAvx2(const int* values, int count, int& min_value, int& max_value)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i large = _mm256_set1_epi32(INT_MAX);
+    __m256i lo = large;
+    __m256i hi = _mm256_set1_epi32(-1);
+
+    int i(0);
+    for (; i + 8 <= count; i += 8) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        lo = _mm256_min_epi32(lo, _mm256_blendv_epi8(v, large, _mm256_cmpgt_epi32(zero, v)));
+        hi = _mm256_max_epi32(hi, v);
+    }
+    int lanes_lo[8];
+    int lanes_hi[8];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes_lo), lo);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes_hi), hi);
+
+    int rest_lo, rest_hi;
+    reduceMinMaxScalar(values + i, count - i, rest_lo, rest_hi);
+    int result_lo = (rest_hi < 0) ? INT_MAX : rest_lo;
+    int result_hi = rest_hi;
+    for (int k(0); k < 8; ++k) {
+        result_lo = std::min(result_lo, lanes_lo[k]);
+        result_hi = std::max(result_hi, lanes_hi[k]);
+    }
+    min_value = (result_hi < 0) ? -1 : result_lo;
+    max_value = result_hi;
+}
+
+__attribute__((target("avx2")))
+int countWithinAvx2(const int* values, int count, int threshold)
+{
+    if (threshold == INT_MAX) { threshold = INT_MAX - 1; }
+    const __m256i below = _mm256_set1_epi32(-1);
+    const __m256i above = _mm256_set1_epi32(threshold + 1);
+
+    int result(0);
+    int i(0);
+    for (; i + 8 <= count; i += 8) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        const __m256i in = _mm256_and_si256(_mm256_cmpgt_epi32(v, below), _mm256_cmpgt_epi32(above, v));
+        result += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(in)));
+    }
+    return result + countWithinScalar(values + i, count - i, threshold);
+}
+
+__attribute__((target("avx2")))
+void buildWithinRowAvx2(const int* values, int width, int threshold, uint64_t* bits)
+{
+    if (threshold == INT_MAX) { threshold = INT_MAX - 1; }
+    const __m256i below = _mm256_set1_epi32(-1);
+    const __m256i above = _mm256_set1_epi32(threshold + 1);
+    std::memset(bits, 0, sizeof(uint64_t) * HexKernelWordCount(width));
+
+    int i(0);
+    for (; i + 8 <= width; i += 8) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        const __m256i in = _mm256_and_si256(_mm256_cmpgt_epi32(v, below), _mm256_cmpgt_epi32(above, v));
+        bits[i / 64] |= uint64_t(_mm256_movemask_ps(_mm256_castsi256_ps(in))) << (i % 64);
+    }
+    for (; i < width; ++i) {
+        if ((0 <= values[i]) && (values[i] <= threshold)) { bits[i / 64] |= uint64_t(1) << (i % 64); }
+    }
+}
+
+const KernelTable s_avx2_table = {
+    buildPassableRowAvx2,
+    relaxAdjacentRowAvx2,
+    relaxSameRowAvx2,
+    reduceMinMaxAvx2,
+    countWithinAvx2,
+    buildWithinRowAvx2,
+};
+
+#endif // HEX_KERNEL_X86
+
+/// 実行環境で使える最も新しい命令セットを取得
+HexKernelIsa detectIsa()
+{
+#if HEX_KERNEL_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))   { return HexKernelAvx2; }
+    if (__builtin_cpu_supports("sse4.1")) { return HexKernelSse41; }
+#endif
+    return HexKernelScalar;
+}
+
+/// 命令セットに対応する処理表を取得
+const KernelTable* tableOf(HexKernelIsa isa)
+{
+#if HEX_KERNEL_X86
+    if (isa == HexKernelAvx2)  { return &s_avx2_table; }
+    if (isa == HexKernelSse41) { return &s_sse41_table; }
+#endif
+    (void)isa;
+    return &s_scalar_table;
+}
+
+/// 使用中の命令セットと処理表
+struct KernelSelection
+{
+    HexKernelIsa isa;
+    const KernelTable* table;
+};
+
+/// 使用中の命令セットと処理表を取得
+/// 初回呼び出し時に実行環境を調べる
+KernelSelection& selection()
+{
+    static KernelSelection s_selection = { detectIsa(), tableOf(detectIsa()) };
+    return s_selection;
+}
+
+} // namespace
+
+
+/// 使用中の命令セットを取得
+HexKernelIsa GetHexKernelIsa()
+{
+    return selection().isa;
+}
+
+/// 使用する命令セットを設定
+HexKernelIsa SetHexKernelIsa(HexKernelIsa isa)
+{
+    const HexKernelIsa supported = detectIsa();
+    KernelSelection& current = selection();
+    current.isa   = (supported < isa) ? supported : isa;
+    current.table = tableOf(current.isa);
+    return current.isa;
+}
+
+/// 一行分のヘックスチップから侵入可能ビット列を作る
+void BuildPassableRow(const HexChip* chips, int width, uint64_t* bits)
+{
+    selection().table->build_passable_row(chips, width, bits);
+}
+
+/// 前線を隣の行へ広げる
+void RelaxAdjacentRow(const uint64_t* frontier, int source_y, const uint64_t* passable,
+                      uint64_t* visited, uint64_t* next, int words)
+{
+    selection().table->relax_adjacent_row(frontier, source_y, passable, visited, next, words);
+}
+
+/// 前線を同じ行の左右へ広げる
+void RelaxSameRow(const uint64_t* frontier, const uint64_t* passable,
+                  uint64_t* visited, uint64_t* next, int words)
+{
+    selection().table->relax_same_row(frontier, passable, visited, next, words);
+}
+
+/// 距離の最小値と最大値を取得
+void ReduceDistanceMinMax(const int* values, int count, int& min_value, int& max_value)
+{
+    selection().table->reduce_min_max(values, count, min_value, max_value);
+}
+
+/// 距離が0以上しきい値以下の要素の数を取得
+int CountDistanceWithin(const int* values, int count, int threshold)
+{
+    return selection().table->count_within(values, count, threshold);
+}
+
+/// 距離が0以上しきい値以下の要素のビット列を作る
+void BuildDistanceWithinRow(const int* values, int width, int threshold, uint64_t* bits)
+{
+    selection().table->build_within_row(values, width, threshold, bits);
+}
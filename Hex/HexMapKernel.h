@@ -0,0 +1,203 @@
+//
+//  HexMapKernel.h
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#ifndef Hex_HexMapKernel_h
+#define Hex_HexMapKernel_h
+
+#include "HexBitMap.h"
+#include "HexMap.h"
+
+#include <stdint.h>
+#include <vector>
+
+/// 一括処理に使う命令セット
+enum HexKernelIsa
+{
+    HexKernelScalar = 0, /// 命令セット拡張なし
+    HexKernelSse41,      /// SSE4.1
+    HexKernelAvx2,       /// AVX2
+};
+
+/// 使用中の命令セットを取得
+/// 初回呼び出し時に実行環境で使える最も新しい命令セットを選ぶ
+/// @retval 命令セット
+HexKernelIsa GetHexKernelIsa();
+
+/// 使用する命令セットを設定
+/// 実行環境で使えない命令セットを指定した場合は使える範囲に下げる
+/// 処理中の他のスレッドがあるときに呼んではならない
+/// @param isa [in] 命令セット
+/// @retval 実際に設定した命令セット
+HexKernelIsa SetHexKernelIsa(HexKernelIsa isa);
+
+/// 一行分のビット列の語数を取得
+/// ビット列は x 番目の位置を (x / 64) 語目の (x % 64) ビット目に置く HexBitMapの一行と同じ並び
+/// @param width [in] 幅
+inline int HexKernelWordCount(int width) { return (width + 63) / 64; }
+
+/// 一行分のヘックスチップから侵入可能ビット列を作る
+/// @param chips [in] 一行分のヘックスチップ
+/// @param width [in] 幅
+/// @param bits [out] 侵入可能ビット列 HexKernelWordCount(width)語 幅を超えるビットは0
+void BuildPassableRow(const HexChip* chips, int width, uint64_t* bits);
+
+/// 前線を隣の行へ広げる
+/// 元の行が偶数行ならば x-1 と x, 奇数行ならば x と x+1 の位置へ広がる
+/// 届いた位置のうち侵入可能で未訪問の位置を次の前線と訪問済みに加える
+/// @param frontier [in] 元の行の前線ビット列
+/// @param source_y [in] 元の行 偶奇だけを見る
+/// @param passable [in] 先の行の侵入可能ビット列
+/// @param visited [in,out] 先の行の訪問済みビット列
+/// @param next [in,out] 先の行の次の前線ビット列
+/// @param words [in] 一行分の語数
+void RelaxAdjacentRow(const uint64_t* frontier, int source_y, const uint64_t* passable,
+                      uint64_t* visited, uint64_t* next, int words);
+
+/// 前線を同じ行の左右へ広げる
+/// @param frontier [in] 行の前線ビット列
+/// @param passable [in] 行の侵入可能ビット列
+/// @param visited [in,out] 行の訪問済みビット列
+/// @param next [in,out] 行の次の前線ビット列
+/// @param words [in] 一行分の語数
+void RelaxSameRow(const uint64_t* frontier, const uint64_t* passable,
+                  uint64_t* visited, uint64_t* next, int words);
+
+/// 距離の最小値と最大値を取得
+/// 負の値 (到達不可能, 侵入不可) は除く
+/// @param values [in] 距離
+/// @param count [in] 要素数
+/// @param min_value [out] 最小値 該当なしならば-1
+/// @param max_value [out] 最大値 該当なしならば-1
+void ReduceDistanceMinMax(const int* values, int count, int& min_value, int& max_value);
+
+/// 距離が0以上しきい値以下の要素の数を取得
+/// @param values [in] 距離
+/// @param count [in] 要素数
+/// @param threshold [in] しきい値
+/// @retval 要素の数
+int CountDistanceWithin(const int* values, int count, int threshold);
+
+/// 距離が0以上しきい値以下の要素のビット列を作る
+/// @param values [in] 一行分の距離
+/// @param width [in] 幅
+/// @param threshold [in] しきい値
+/// @param bits [out] ビット列 HexKernelWordCount(width)語
+void BuildDistanceWithinRow(const int* values, int width, int threshold, uint64_t* bits);
+
+
+/// ヘックスマップから侵入可否の層を作る
+/// @param map [in] ヘックスマップ
+/// @param passable [out] 侵入可能な位置のビットが立った層
+template <int Width, int Height>
+void BuildPassableBitMap(const HexMap<HexChip, Width, Height>& map, HexBitMap& passable)
+{
+    passable.Resize(map.GetWidth(), map.GetHeight());
+    for (int j(0); j < map.GetHeight(); ++j) {
+        BuildPassableRow(&map[HexMapPosition(0, j)], map.GetWidth(), passable.GetRow(j));
+    }
+}
+
+/// 侵入可否の層から距離マップを行単位のビット演算で生成する
+/// 前線を行ごとのビット列で持ち, 一段ごとに前線のある行を一括で広げる
+/// 一段ごとに行全体を走査するので, 段数が少なく前線が広いマップほど向く
+/// 距離マップはGeneratePathMapと一致する 経路マップは作らない
+/// @param passable [in] 侵入可能な位置のビットが立った層
+/// @param start [in] 開始地点
+/// @param distance_map [out] 距離マップ 到達できない位置はPathDistanceUnreachable 侵入不可の位置はPathDistanceNoEntry
+/// @retval 到達できた位置の数
+template <int Width, int Height>
+int GenerateDistanceMapByRows(const HexBitMap& passable,
+                              const HexMapPosition& start,
+                              HexMap<int, Width, Height>& distance_map)
+{
+    assert((distance_map.GetWidth() == passable.GetWidth()) && (distance_map.GetHeight() == passable.GetHeight()));
+
+    const int width  = passable.GetWidth();
+    const int height = passable.GetHeight();
+    const int words  = passable.GetWordCount();
+    std::vector<uint64_t> visited(words * height, 0);
+    std::vector<uint64_t> frontier(words * height, 0);
+    std::vector<uint64_t> next(words * height, 0);
+    std::vector<unsigned char> active(height, 0);
+
+    for (int j(0); j < height; ++j) {
+        for (int i(0); i < width; ++i) {
+            const HexMapPosition pos(i, j);
+            distance_map[pos] = passable[pos] ? PathDistanceUnreachable : PathDistanceNoEntry;
+        }
+    }
+    if (! IsEntriable(passable, start)) { return 0; }
+
+    /// 開始地点設定
+    const uint64_t start_bit = uint64_t(1) << (start.X() % 64);
+    frontier[words * start.Y() + start.X() / 64] = start_bit;
+    visited[words * start.Y() + start.X() / 64]  = start_bit;
+    active[start.Y()] = 1;
+    distance_map[start] = 0;
+    int reached(1);
+
+    // 前線のある行の範囲
+    int top(start.Y());
+    int bottom(start.Y());
+    for (int distance(1); top <= bottom; ++distance) {
+        const int next_top    = std::max(0, top - 1);
+        const int next_bottom = std::min(height - 1, bottom + 1);
+
+        for (int j(top); j <= bottom; ++j) {
+            if (! active[j]) { continue; }
+            const uint64_t* source = &frontier[words * j];
+            if (0 < j) {
+                RelaxAdjacentRow(source, j, passable.GetRow(j - 1), &visited[words * (j - 1)], &next[words * (j - 1)], words);
+            }
+            if (j < height - 1) {
+                RelaxAdjacentRow(source, j, passable.GetRow(j + 1), &visited[words * (j + 1)], &next[words * (j + 1)], words);
+            }
+            RelaxSameRow(source, passable.GetRow(j), &visited[words * j], &next[words * j], words);
+        }
+
+        // 届いた位置に距離を書き込み, 次の前線の行の範囲を求める
+        top    = height;
+        bottom = -1;
+        for (int j(next_top); j <= next_bottom; ++j) {
+            active[j] = 0;
+            for (int w(0); w < words; ++w) {
+                uint64_t bits = next[words * j + w];
+                frontier[words * j + w] = bits;
+                next[words * j + w] = 0;
+                if (bits == 0) { continue; }
+
+                active[j] = 1;
+                top    = std::min(top, j);
+                bottom = std::max(bottom, j);
+                for (int b(0); bits != 0; ++b, bits >>= 1) {
+                    if ((bits & 1) == 0) { continue; }
+                    distance_map[HexMapPosition(w * 64 + b, j)] = distance;
+                    ++reached;
+                }
+            }
+        }
+    }
+    return reached;
+}
+
+/// 距離マップを行単位のビット演算で生成する
+/// @param map [in] ヘックスマップ
+/// @param start [in] 開始地点
+/// @param distance_map [out] 距離マップ 到達できない位置はPathDistanceUnreachable 侵入不可の位置はPathDistanceNoEntry
+/// @retval 到達できた位置の数
+template <int Width, int Height>
+int GenerateDistanceMapByRows(const HexMap<HexChip, Width, Height>& map,
+                              const HexMapPosition& start,
+                              HexMap<int, Width, Height>& distance_map)
+{
+    HexBitMap passable;
+    BuildPassableBitMap(map, passable);
+    return GenerateDistanceMapByRows(passable, start, distance_map);
+}
+
+#endif
@@ -10,13 +10,7 @@
 
 
 
-/// 隣要素取得関数テーブル
-const HexMapPosition::NeighborFunc HexMapPosition::s_neighbor_func[] =
-{
-    &HexMapPosition::GetRightUp,
-    &HexMapPosition::GetRight,
-    &HexMapPosition::GetRightDown,
-    &HexMapPosition::GetLeftDown,
-    &HexMapPosition::GetLeft,
-    &HexMapPosition::GetLeftUp
-};
\ No newline at end of file
+/// 隣へのx座標の差分
+constexpr int HexMapPosition::s_neighbor_x[2][HexMapPosition::NeighborCount];
+/// 隣へのy座標の差分
+constexpr int HexMapPosition::s_neighbor_y[HexMapPosition::NeighborCount];
@@ -9,14 +9,19 @@
 #ifndef Hex_HexMapPosition_h
 #define Hex_HexMapPosition_h
 
+#include <cassert>
+#include <cstddef>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <stdint.h>
 
 /// ヘックスマップ位置
 class HexMapPosition
 {
 public:
     /// コンストラクタ
-    HexMapPosition()
+    constexpr HexMapPosition()
     :m_x(0)
     ,m_y(0)
     {}
@@ -24,7 +29,7 @@ public:
     /// コンストラクタ
     /// @param x [in] x位置
     /// @param y [in] y位置
-    HexMapPosition(int x, int y)
+    constexpr HexMapPosition(int x, int y)
     :m_x(x)
     ,m_y(y)
     {}
@@ -42,88 +47,101 @@ public:
         NeighborCount, // 総数
     };
     
-    /// 型定義 隣の位置取得関数
-    typedef HexMapPosition (HexMapPosition::*NeighborFunc)() const;
+    /// 隣へのx座標の差分 [行の偶奇][隣指定]
+    /// 奇数行は右にずれているので, 上下の隣は行の偶奇でx座標の差分が変わる
+    static constexpr int s_neighbor_x[2][NeighborCount] =
+    {
+        { 0, 1, 0, -1, -1, -1 }, // 偶数行
+        { 1, 1, 1,  0, -1,  0 }, // 奇数行
+    };
     
-    /// 隣位置取得関数テーブル
-    static NeighborFunc s_neighbor_func[];
+    /// 隣へのy座標の差分 [隣指定]
+    static constexpr int s_neighbor_y[NeighborCount] = { -1, 0, 1, 1, 0, -1 };
     
-    /// 隣取得関数を取得
-    HexMapPosition GetNeighbor(Neighbor n) const { return (this->*s_neighbor_func[n])(); }
+    /// 隣を取得
+    /// 行の偶奇で表を引くので分岐しない
+    /// @param n [in] 隣指定
+    /// @retval 隣の位置
+    constexpr HexMapPosition GetNeighbor(Neighbor n) const
+    {
+        return HexMapPosition(m_x + s_neighbor_x[m_y & 1][n], m_y + s_neighbor_y[n]);
+    }
     
     /// 左隣を取得
     /// @retval 左隣
-    HexMapPosition GetLeft() const
+    constexpr HexMapPosition GetLeft() const
     {
-        return HexMapPosition(m_x - 1, m_y);
+        return GetNeighbor(Left);
     }
     
     /// 右隣を取得
     /// @retval 右隣
-    HexMapPosition GetRight() const
+    constexpr HexMapPosition GetRight() const
     {
-        return HexMapPosition(m_x + 1, m_y);
+        return GetNeighbor(Right);
     }
     
     /// 右上隣を取得
     /// @retval 右上隣
-    HexMapPosition GetRightUp() const
+    constexpr HexMapPosition GetRightUp() const
     {
-        return (isEven()) ? HexMapPosition(m_x, m_y - 1) : HexMapPosition(m_x + 1, m_y - 1);
+        return GetNeighbor(RightUp);
     }
     
     /// 右下隣を取得
     /// @retval 右下隣
-    HexMapPosition GetRightDown() const
+    constexpr HexMapPosition GetRightDown() const
     {
-        return (isEven()) ? HexMapPosition(m_x, m_y + 1) : HexMapPosition(m_x + 1, m_y + 1);
+        return GetNeighbor(RightDown);
     }
     
     /// 左上隣を取得
     /// @retval 左上隣を取得
-    HexMapPosition GetLeftUp() const
+    constexpr HexMapPosition GetLeftUp() const
     {
-        return (isEven()) ? HexMapPosition(m_x - 1, m_y - 1) : HexMapPosition(m_x, m_y - 1);
+        return GetNeighbor(LeftUp);
     }
     
     /// 左下隣を取得
     /// @retval 左下隣
-    HexMapPosition GetLeftDown() const
+    constexpr HexMapPosition GetLeftDown() const
     {
-        return (isEven()) ? HexMapPosition(m_x - 1, m_y + 1) : HexMapPosition(m_x, m_y + 1);
+        return GetNeighbor(LeftDown);
     }
     
     
     /// x座標を取得
     /// @retval x位置
-    int X() const { return m_x; }
+    constexpr int X() const { return m_x; }
     /// y座標を取得
     /// @retval y位置
-    int Y() const { return m_y; }
+    constexpr int Y() const { return m_y; }
     
     /// 一致比較
     /// @retval 同じ位置を示すならばtrue そうでなければfalse
-    bool operator==(const HexMapPosition& pos) const
+    constexpr bool operator==(const HexMapPosition& pos) const
     {
         return (m_x == pos.m_x) && (m_y == pos.m_y);
     }
     
     /// 非一致比較
     /// @retval 同じ位置を示していなければtrue そうでなければfalse
-    bool operator!=(const HexMapPosition& pos) const
+    constexpr bool operator!=(const HexMapPosition& pos) const
     {
         return (m_x != pos.m_x) || (m_y != pos.m_y);
     }
     
+    /// 順序比較
+    /// マップの並びと同じく, y座標, x座標の順に比べる
+    /// @retval この位置が前ならばtrue そうでなければfalse
+    constexpr bool operator<(const HexMapPosition& pos) const
+    {
+        return (m_y < pos.m_y) || ((m_y == pos.m_y) && (m_x < pos.m_x));
+    }
+    
 private:
     int m_x; /// x位置
     int m_y; /// y位置
-    
-private:
-    /// 奇数列か否か
-    bool isOdd() const  { return m_y % 2 == 1; }
-    /// 偶数列か否か
-    bool isEven() const { return m_y % 2 == 0; }
 };
 
 
@@ -134,7 +152,36 @@ inline std::ostream& operator<<(std::ostream& os, const HexMapPosition& pos)
     os << '(' << pos.X() << ',' << pos.Y() << ')';
     return os;
 }
+
+/// 位置のハッシュ
+/// x, y座標を64ビットに詰めてから攪拌する 下位ビットだけを使っても偏らない
+struct HexMapPositionHash
+{
+    std::size_t operator()(const HexMapPosition& pos) const
+    {
+        uint64_t h = (static_cast<uint64_t>(static_cast<uint32_t>(pos.X())) << 32) | static_cast<uint32_t>(pos.Y());
+        h ^= h >> 33;
+        h *= UINT64_C(0xff51afd7ed558ccd);
+        h ^= h >> 33;
+        h *= UINT64_C(0xc4ceb9fe1a85ec53);
+        h ^= h >> 33;
+        return static_cast<std::size_t>(h);
+    }
+};
+
+namespace std
+{
+    /// 標準の非順序コンテナ向けのハッシュ
+    template <>
+    struct hash<HexMapPosition> : public HexMapPositionHash {};
+}
     
+/// 大きさを実行時に決めることを表すマップの幅・高さ
+enum HexMapExtent
+{
+    HexMapDynamic = -1,
+};
+
 /// @class ヘックスマップの位置指定イテレータ
 /// @tparam Width マップの幅
 /// @tparam Height マップの高さ
@@ -145,7 +192,8 @@ public:
     /// イテレータ特性
     typedef std::forward_iterator_tag iterator_category;
     typedef HexMapPosition value_type;
-    typedef HexMapPosition* pointer;
+    typedef std::ptrdiff_t difference_type;
+    typedef const HexMapPosition* pointer;
     typedef HexMapPosition& reference;
     
     /// コンストラクタ
@@ -174,6 +222,12 @@ public:
     {
         return m_pos;
     }
+
+    /// メンバアクセス
+    const HexMapPosition* operator->() const
+    {
+        return &m_pos;
+    }
         
     /// 一致比較
     /// @param tgt [in] 比較対象
@@ -193,13 +247,23 @@ public:
     }
         
     /// インクリメント
+    /// 行末の次は次の行の先頭 最終行の次は終端(0, Height) 終端は進めないこと
     /// @retval インクリメント後の自身
     HexMapPositionIterator<Width, Height>& operator++()
     {
-        if (m_pos.X() < Width - 1) { m_pos = HexMapPosition(m_pos.X() + 1, m_pos.Y()); }
-        else if (m_pos.Y() < Height) { m_pos = HexMapPosition(0, m_pos.Y() + 1); }
+        assert(m_pos.Y() < Height);
+        m_pos = (m_pos.X() + 1 < Width) ? HexMapPosition(m_pos.X() + 1, m_pos.Y()) : HexMapPosition(0, m_pos.Y() + 1);
         return *this;
     }
+
+    /// 後置インクリメント
+    /// @retval インクリメント前の自身
+    HexMapPositionIterator<Width, Height> operator++(int)
+    {
+        const HexMapPositionIterator<Width, Height> previous(*this);
+        ++*this;
+        return previous;
+    }
         
     /// 先頭要素
     static HexMapPositionIterator<Width, Height> begin()
@@ -216,6 +280,113 @@ public:
 private:
     HexMapPosition m_pos; /// 位置
 };
+
+/// @class 大きさを実行時に決めるヘックスマップの位置指定イテレータ
+template <>
+class HexMapPositionIterator<HexMapDynamic, HexMapDynamic>
+{
+public:
+    /// イテレータ特性
+    typedef std::forward_iterator_tag iterator_category;
+    typedef HexMapPosition value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const HexMapPosition* pointer;
+    typedef HexMapPosition& reference;
+    
+    /// コンストラクタ
+    HexMapPositionIterator()
+    :m_pos()
+    ,m_width(0)
+    ,m_height(0)
+    {}
+    
+    /// コンストラクタ
+    /// @param x [in] x位置
+    /// @param y [in] y位置
+    /// @param width [in] マップの幅
+    /// @param height [in] マップの高さ
+    HexMapPositionIterator(int x, int y, int width, int height)
+    :m_pos(x,y)
+    ,m_width(width)
+    ,m_height(height)
+    {}
+    
+    /// 参照外し
+    /// @retval 現在の位置指定
+    HexMapPosition& operator*()
+    {
+        return m_pos;
+    }
+    
+    /// 参照外し
+    /// @retval 現在の位置指定
+    const HexMapPosition& operator*() const
+    {
+        return m_pos;
+    }
+
+    /// メンバアクセス
+    const HexMapPosition* operator->() const
+    {
+        return &m_pos;
+    }
+    
+    /// 一致比較
+    /// @param tgt [in] 比較対象
+    /// @retval 同じ位置をしめしているならばtrue そうでなければfalse
+    bool operator==(const HexMapPositionIterator<HexMapDynamic, HexMapDynamic>& tgt) const
+    {
+        return m_pos == tgt.m_pos;
+    }
+    
+    /// 非一致比較
+    /// @param tgt [in] 比較対象
+    /// @retval 非一致ならばtrue そうでなければ(一致ならば)false
+    bool operator!=(const HexMapPositionIterator<HexMapDynamic, HexMapDynamic>& tgt) const
+    {
+        return m_pos != tgt.m_pos;
+    }
+    
+    /// インクリメント
+    /// 行末の次は次の行の先頭 最終行の次は終端(0, height) 終端は進めないこと
+    /// @retval インクリメント後の自身
+    HexMapPositionIterator<HexMapDynamic, HexMapDynamic>& operator++()
+    {
+        assert(m_pos.Y() < m_height);
+        m_pos = (m_pos.X() + 1 < m_width) ? HexMapPosition(m_pos.X() + 1, m_pos.Y()) : HexMapPosition(0, m_pos.Y() + 1);
+        return *this;
+    }
+
+    /// 後置インクリメント
+    /// @retval インクリメント前の自身
+    HexMapPositionIterator<HexMapDynamic, HexMapDynamic> operator++(int)
+    {
+        const HexMapPositionIterator<HexMapDynamic, HexMapDynamic> previous(*this);
+        ++*this;
+        return previous;
+    }
+    
+    /// 先頭要素
+    /// @param width [in] マップの幅
+    /// @param height [in] マップの高さ
+    static HexMapPositionIterator<HexMapDynamic, HexMapDynamic> begin(int width, int height)
+    {
+        return HexMapPositionIterator<HexMapDynamic, HexMapDynamic>(0, 0, width, height);
+    }
+    
+    /// 終端要素
+    /// @param width [in] マップの幅
+    /// @param height [in] マップの高さ
+    static HexMapPositionIterator<HexMapDynamic, HexMapDynamic> end(int width, int height)
+    {
+        return HexMapPositionIterator<HexMapDynamic, HexMapDynamic>(0, height, width, height);
+    }
+    
+private:
+    HexMapPosition m_pos; /// 位置
+    int m_width;          /// マップの幅
+    int m_height;         /// マップの高さ
+};
     
 /// 出力オペレータ
 /// @param os [in] 出力先のストリーム
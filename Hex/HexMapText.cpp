@@ -0,0 +1,66 @@
+//
+//  HexMapText.cpp
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#include "HexMapText.h"
+
+#include <climits>
+
+namespace {
+
+/// 整数を読む
+/// @param text [in,out] 読む位置 読んだ後ろへ進む
+/// @param last [in] 終端
+/// @param value [out] 値
+/// @retval 読めればtrue
+bool parseInt(const char*& text, const char* last, int& value)
+{
+    bool negative(false);
+    if ((text != last) && ((*text == '-') || (*text == '+'))) {
+        negative = (*text == '-');
+        ++text;
+    }
+    if ((text == last) || (*text < '0') || ('9' < *text)) { return false; }
+
+    // 負の側で累積すれば INT_MIN まで桁あふれせずに読める
+    long long result(0);
+    for (; (text != last) && ('0' <= *text) && (*text <= '9'); ++text) {
+        result = result * 10 - (*text - '0');
+        if (result < INT_MIN) { return false; }
+    }
+    if (! negative) {
+        result = -result;
+        if (INT_MAX < result) { return false; }
+    }
+    value = static_cast<int>(result);
+    return true;
+}
+
+}
+
+/// 整数の文字列からの変換
+bool HexMapTextCell<int>::Parse(const char* text, std::size_t length, int& value)
+{
+    const char* last = text + length;
+    return parseInt(text, last, value) && (text == last);
+}
+
+/// 位置の文字列からの変換
+bool HexMapTextCell<HexMapPosition>::Parse(const char* text, std::size_t length, HexMapPosition& value)
+{
+    const char* last = text + length;
+    int x(0);
+    int y(0);
+    if ((text == last) || (*text++ != '(')) { return false; }
+    if (! parseInt(text, last, x)) { return false; }
+    if ((text == last) || (*text++ != ',')) { return false; }
+    if (! parseInt(text, last, y)) { return false; }
+    if ((text == last) || (*text++ != ')')) { return false; }
+    if (text != last) { return false; }
+    value = HexMapPosition(x, y);
+    return true;
+}
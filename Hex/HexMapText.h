@@ -0,0 +1,257 @@
+//
+//  HexMapText.h
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#ifndef Hex_HexMapText_h
+#define Hex_HexMapText_h
+
+#include "HexChip.h"
+#include "HexMapPosition.h"
+
+#include <cstddef>
+#include <iostream>
+#include <streambuf>
+
+/// @class 書き込まれた文字数を数えるだけのストリームバッファ
+/// 要素の文字列の長さを, 文字列を作らずに測るために使う
+class HexTextCounter : public std::streambuf
+{
+public:
+    /// コンストラクタ
+    HexTextCounter()
+    :m_count(0)
+    {}
+
+    /// 数えた文字数を取得
+    std::streamsize GetCount() const { return m_count; }
+
+protected:
+    virtual int_type overflow(int_type c)
+    {
+        if (! traits_type::eq_int_type(c, traits_type::eof())) { ++m_count; }
+        return traits_type::not_eof(c);
+    }
+
+    virtual std::streamsize xsputn(const char*, std::streamsize n)
+    {
+        m_count += n;
+        return n;
+    }
+
+private:
+    std::streamsize m_count; /// 文字数
+};
+
+/// 要素を出力したときの文字数を取得
+/// @param value [in] 要素
+/// @retval 文字数
+template <class T>
+int MeasureHexMapText(const T& value)
+{
+    HexTextCounter counter;
+    std::ostream os(&counter);
+    os << value;
+    return static_cast<int>(counter.GetCount());
+}
+
+/// 奇数行の字下げの文字数を取得
+/// 要素の半分ずらすと六角形の並びになる
+/// @param cell_length [in] 先頭の要素の文字数
+inline int HexMapTextIndent(int cell_length) { return cell_length / 2 + 1; }
+
+
+/// @class 要素の文字列からの変換
+/// 出力オペレータの逆変換 読み込む型ごとに特殊化する
+/// @tparam T 要素型
+template <class T>
+struct HexMapTextCell;
+
+/// 地形の文字列からの変換
+template <>
+struct HexMapTextCell<HexChip>
+{
+    /// @param text [in] 文字の先頭
+    /// @param length [in] 文字数
+    /// @param value [out] 要素
+    /// @retval 変換できればtrue
+    static bool Parse(const char* text, std::size_t length, HexChip& value)
+    {
+        HexChip::Type type;
+        if (! HexChip::FromString(text, length, type)) { return false; }
+        value = type;
+        return true;
+    }
+};
+
+/// 整数の文字列からの変換
+template <>
+struct HexMapTextCell<int>
+{
+    static bool Parse(const char* text, std::size_t length, int& value);
+};
+
+/// 位置の文字列からの変換 (x,y)
+template <>
+struct HexMapTextCell<HexMapPosition>
+{
+    static bool Parse(const char* text, std::size_t length, HexMapPosition& value);
+};
+
+
+/// @class ヘックスマップのテキスト書き出し
+/// 行ごとに |要素|要素| の形で書き, 奇数行は先頭の要素の半分だけ字下げする
+/// 文字列を作らず出力ストリームへ直接書き, 行末は'\n'でフラッシュしない
+class HexMapTextWriter
+{
+public:
+    /// コンストラクタ
+    /// @param os [in] 出力先
+    explicit HexMapTextWriter(std::ostream& os)
+    :m_os(os)
+    ,m_row(0)
+    ,m_indent(-1)
+    {}
+
+    /// 一行書き出す
+    /// 字下げは最初の行の先頭の要素で決める
+    /// @tparam InputIterator 要素を指す入力イテレータ
+    /// @param first [in] 行の先頭
+    /// @param last [in] 行の終端
+    template <class InputIterator>
+    void WriteRow(InputIterator first, InputIterator last)
+    {
+        if ((m_indent < 0) && (first != last)) { m_indent = HexMapTextIndent(MeasureHexMapText(*first)); }
+        if ((m_row % 2 == 1) && (0 < m_indent)) {
+            for (int i(0); i < m_indent; ++i) { m_os.put(' '); }
+        }
+        m_os.put('|');
+        for (; first != last; ++first) {
+            m_os << *first;
+            m_os.put('|');
+        }
+        m_os.put('\n');
+        ++m_row;
+    }
+
+    /// 書き出した行数取得
+    int GetRowCount() const { return m_row; }
+
+private:
+    std::ostream& m_os; /// 出力先
+    int m_row;          /// 書き出した行数
+    int m_indent;       /// 奇数行の字下げ 未決定ならば-1
+};
+
+
+/// @class ヘックスマップのテキスト読み込み
+/// 出力オペレータとHexMapTextWriterの形式を一行ずつ読む
+/// 入力は固定長のバッファで少しずつ読み, 要素は一つずつ変換して渡すので, 行の長さにもマップの大きさにも依存せずメモリを確保しない
+/// @tparam T 要素型 HexMapTextCell<T>が必要
+template <class T>
+class HexMapTextReader
+{
+public:
+    /// 入力のバッファの大きさ
+    static const int BufferSize = 8192;
+    /// 要素一つの最大文字数
+    static const int MaxCellLength = 64;
+
+    /// 読み込みの結果
+    enum Result
+    {
+        RowRead,     /// 一行読んだ
+        EndOfInput,  /// 入力の終端
+        FormatError, /// 形式が違う
+    };
+
+    /// コンストラクタ
+    /// @param is [in] 入力元
+    explicit HexMapTextReader(std::istream& is)
+    :m_is(is)
+    ,m_begin(0)
+    ,m_end(0)
+    ,m_line(0)
+    {}
+
+    /// 一行読み込む
+    /// 空行は読み飛ばす
+    /// @tparam OutputIterator Tを受け取る出力イテレータ
+    /// @param out [out] 要素の出力先
+    /// @param limit [in] 一行の要素の数の上限 超えたら形式が違うとみなし, それ以上は出力しない
+    /// @param count [out] 読んだ要素の数
+    /// @retval 結果
+    template <class OutputIterator>
+    Result ReadRow(OutputIterator out, int limit, int& count)
+    {
+        count = 0;
+        int c = skipBlank();
+        if (c == eof()) { return EndOfInput; }
+        ++m_line;
+        if (c != '|') { return FormatError; }
+
+        char cell[MaxCellLength];
+        for (;;) {
+            // 次の区切りまでを一つの要素とする
+            std::size_t length(0);
+            for (c = get(); (c != '|') && (c != '\n') && (c != eof()); c = get()) {
+                if (c == '\r') { continue; }
+                if (length == sizeof(cell)) { return FormatError; }
+                cell[length++] = static_cast<char>(c);
+            }
+            if (c != '|') {
+                // 最後の区切りの後ろは行末
+                return (length == 0) ? RowRead : FormatError;
+            }
+
+            T value;
+            if (limit <= count) { return FormatError; }
+            if (! HexMapTextCell<T>::Parse(cell, length, value)) { return FormatError; }
+            *out = value;
+            ++out;
+            ++count;
+        }
+    }
+
+    /// 読んだ行数取得
+    /// 形式が違うときの位置の報告に使う
+    int GetLine() const { return m_line; }
+
+private:
+    /// 入力の終端
+    static int eof() { return -1; }
+
+    /// 一文字読む
+    int get()
+    {
+        if (m_begin == m_end) {
+            m_is.read(m_buffer, sizeof(m_buffer));
+            m_begin = 0;
+            m_end   = static_cast<int>(m_is.gcount());
+            if (m_end == 0) { return eof(); }
+        }
+        return static_cast<unsigned char>(m_buffer[m_begin++]);
+    }
+
+    /// 空白と空行を読み飛ばして次の文字を読む
+    int skipBlank()
+    {
+        int c = get();
+        while ((c == ' ') || (c == '\n') || (c == '\r') || (c == '\t')) { c = get(); }
+        return c;
+    }
+
+    std::istream& m_is;         /// 入力元
+    char m_buffer[BufferSize];  /// 入力のバッファ
+    int m_begin;                /// バッファの未読の先頭
+    int m_end;                  /// バッファの終端
+    int m_line;                 /// 読んだ行数
+};
+
+template <class T> const int HexMapTextReader<T>::BufferSize;
+template <class T> const int HexMapTextReader<T>::MaxCellLength;
+
+#endif
@@ -0,0 +1,372 @@
+//
+//  HexMapView.h
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#ifndef Hex_HexMapView_h
+#define Hex_HexMapView_h
+
+#include "HexMap.h"
+#include "HexMapPosition.h"
+
+#include <algorithm>
+#include <cassert>
+
+/// 切り出す矩形を参照の範囲に縮める
+/// 行の偶奇で隣の位置が変わるので, 上端は偶数の行に揃える
+/// @param bound_width [in] 参照の幅
+/// @param bound_height [in] 参照の高さ
+/// @param left [in] 左端のx位置
+/// @param top [in] 上端のy位置
+/// @param width [in] 幅
+/// @param height [in] 高さ
+/// @param x0 [out] 縮めた左端
+/// @param y0 [out] 縮めた上端
+/// @param x1 [out] 縮めた右端の次
+/// @param y1 [out] 縮めた下端の次
+inline void ClipHexMapSlice(int bound_width, int bound_height, int left, int top, int width, int height,
+                            int& x0, int& y0, int& x1, int& y1)
+{
+    x0 = std::min(std::max(left, 0), bound_width);
+    y0 = std::min(std::max(top, 0) & ~1, bound_height);
+    x1 = std::max(std::min(left + width, bound_width), x0);
+    y1 = std::max(std::min(top + height, bound_height), y0);
+}
+
+/// @class 読み取り専用のヘックスマップ参照
+/// 行順に並んだ要素を所有せずに参照する HexMapや読み込んだファイルの領域を包む
+/// 要素アクセスはHexMapと同じ書き方ができる
+/// 行の間隔を持つので, 大きなマップの一部の矩形を複製せずに切り出せる
+/// 切り出した参照の位置は切り出した矩形の左上を原点とし, 元のマップでの原点の位置を持つ
+/// @tparam T ヘックスマップで保持する値
+template <class T>
+class HexMapView
+{
+public:
+    /// コンストラクタ
+    /// 空の参照を作る
+    HexMapView()
+    :m_data(NULL)
+    ,m_width(0)
+    ,m_height(0)
+    ,m_stride(0)
+    ,m_origin()
+    {}
+
+    /// コンストラクタ
+    /// @param data [in] 行順に並んだ要素の先頭 width * height個
+    /// @param width [in] 幅
+    /// @param height [in] 高さ
+    HexMapView(const T* data, int width, int height)
+    :m_data(data)
+    ,m_width(width)
+    ,m_height(height)
+    ,m_stride(width)
+    ,m_origin()
+    {
+        assert((0 <= width) && (0 <= height));
+        assert((data != NULL) || (width * height == 0));
+    }
+
+    /// コンストラクタ
+    /// @param data [in] 行順に並んだ要素の先頭
+    /// @param width [in] 幅
+    /// @param height [in] 高さ
+    /// @param stride [in] 行の先頭の間隔 幅以上
+    /// @param origin [in] 元のマップでの原点の位置
+    HexMapView(const T* data, int width, int height, int stride, const HexMapPosition& origin)
+    :m_data(data)
+    ,m_width(width)
+    ,m_height(height)
+    ,m_stride(stride)
+    ,m_origin(origin)
+    {
+        assert((0 <= width) && (0 <= height) && (width <= stride));
+        assert((data != NULL) || (width * height == 0));
+    }
+
+    /// コンストラクタ
+    /// ヘックスマップ全体を参照する
+    /// @param map [in] ヘックスマップ
+    template <int Width, int Height>
+    HexMapView(const HexMap<T, Width, Height>& map)
+    :m_data((0 < map.Size()) ? &map[HexMapPosition(0, 0)] : NULL)
+    ,m_width(map.GetWidth())
+    ,m_height(map.GetHeight())
+    ,m_stride(map.GetWidth())
+    ,m_origin()
+    {}
+
+    /// 要素アクセス
+    inline const T& operator[](const HexMapPosition& pos) const { return At(pos); }
+
+    /// 要素アクセス
+    inline const T& At(const HexMapPosition& pos) const { return m_data[pos.X() + m_stride * pos.Y()]; }
+
+    /// 一行分の要素の先頭取得
+    /// @param y [in] 行
+    const T* GetRow(int y) const { return m_data + m_stride * y; }
+
+    /// 矩形を切り出す
+    /// 矩形は参照の範囲に縮める 行の偶奇で隣の位置が変わるので, 上端が奇数の行ならば一行上から切り出す
+    /// @param left [in] 左端のx位置
+    /// @param top [in] 上端のy位置
+    /// @param width [in] 幅
+    /// @param height [in] 高さ
+    /// @retval 矩形の参照
+    HexMapView Slice(int left, int top, int width, int height) const
+    {
+        int x0, y0, x1, y1;
+        ClipHexMapSlice(m_width, m_height, left, top, width, height, x0, y0, x1, y1);
+        return HexMapView(m_data + x0 + m_stride * y0, x1 - x0, y1 - y0, m_stride,
+                          HexMapPosition(m_origin.X() + x0, m_origin.Y() + y0));
+    }
+
+    /// 元のマップでの位置取得
+    /// @param pos [in] この参照での位置
+    HexMapPosition ToSource(const HexMapPosition& pos) const
+    {
+        return HexMapPosition(pos.X() + m_origin.X(), pos.Y() + m_origin.Y());
+    }
+
+    /// この参照での位置取得
+    /// @param pos [in] 元のマップでの位置
+    HexMapPosition FromSource(const HexMapPosition& pos) const
+    {
+        return HexMapPosition(pos.X() - m_origin.X(), pos.Y() - m_origin.Y());
+    }
+
+    /// 幅取得
+    inline int GetWidth()  const { return m_width; }
+    /// 高さ取得
+    inline int GetHeight() const { return m_height; }
+    /// 大きさ取得
+    inline int Size() const { return m_width * m_height; }
+    /// 空であるか否か
+    inline bool Empty() const { return Size() == 0; }
+    /// 行の先頭の間隔取得
+    inline int GetStride() const { return m_stride; }
+    /// 元のマップでの原点の位置取得
+    inline const HexMapPosition& GetOrigin() const { return m_origin; }
+    /// 要素が隙間なく並んでいるか否か
+    inline bool IsContiguous() const { return (m_stride == m_width) || (m_height <= 1); }
+
+    /// 要素の先頭取得
+    const T* Data() const { return m_data; }
+
+    /// 要素の範囲 隙間なく並んでいること
+    const T* begin() const { assert(IsContiguous()); return m_data; }
+    const T* end()   const { assert(IsContiguous()); return m_data + Size(); }
+
+private:
+    const T* m_data;         /// 要素の先頭
+    int m_width;             /// 幅
+    int m_height;            /// 高さ
+    int m_stride;            /// 行の先頭の間隔
+    HexMapPosition m_origin; /// 元のマップでの原点の位置
+};
+
+
+/// @class 書き込めるヘックスマップ参照
+/// HexMapViewと同じく要素を所有せず, 切り出した矩形に直接書き込める
+/// 地形の編集や, 経路マップを大きなマップの一部や呼び出し側の領域に書き込むときに使う
+/// @tparam T ヘックスマップで保持する値
+template <class T>
+class HexMapSpan
+{
+public:
+    /// コンストラクタ
+    /// 空の参照を作る
+    HexMapSpan()
+    :m_data(NULL)
+    ,m_width(0)
+    ,m_height(0)
+    ,m_stride(0)
+    ,m_origin()
+    {}
+
+    /// コンストラクタ
+    /// @param data [in] 行順に並んだ要素の先頭
+    /// @param width [in] 幅
+    /// @param height [in] 高さ
+    /// @param stride [in] 行の先頭の間隔 幅以上
+    /// @param origin [in] 元のマップでの原点の位置
+    HexMapSpan(T* data, int width, int height, int stride, const HexMapPosition& origin)
+    :m_data(data)
+    ,m_width(width)
+    ,m_height(height)
+    ,m_stride(stride)
+    ,m_origin(origin)
+    {
+        assert((0 <= width) && (0 <= height) && (width <= stride));
+        assert((data != NULL) || (width * height == 0));
+    }
+
+    /// コンストラクタ
+    /// ヘックスマップ全体を参照する
+    /// @param map [in] ヘックスマップ
+    template <int Width, int Height>
+    HexMapSpan(HexMap<T, Width, Height>& map)
+    :m_data((0 < map.Size()) ? &map[HexMapPosition(0, 0)] : NULL)
+    ,m_width(map.GetWidth())
+    ,m_height(map.GetHeight())
+    ,m_stride(map.GetWidth())
+    ,m_origin()
+    {}
+
+    /// 読み取り専用の参照に変換
+    operator HexMapView<T>() const { return HexMapView<T>(m_data, m_width, m_height, m_stride, m_origin); }
+
+    /// 要素アクセス
+    inline T& operator[](const HexMapPosition& pos) const { return At(pos); }
+
+    /// 要素アクセス
+    inline T& At(const HexMapPosition& pos) const { return m_data[pos.X() + m_stride * pos.Y()]; }
+
+    /// 一行分の要素の先頭取得
+    /// @param y [in] 行
+    T* GetRow(int y) const { return m_data + m_stride * y; }
+
+    /// 矩形を切り出す
+    /// HexMapView::Sliceと同じく, 上端が奇数の行ならば一行上から切り出す
+    /// @param left [in] 左端のx位置
+    /// @param top [in] 上端のy位置
+    /// @param width [in] 幅
+    /// @param height [in] 高さ
+    /// @retval 矩形の参照
+    HexMapSpan Slice(int left, int top, int width, int height) const
+    {
+        int x0, y0, x1, y1;
+        ClipHexMapSlice(m_width, m_height, left, top, width, height, x0, y0, x1, y1);
+        return HexMapSpan(m_data + x0 + m_stride * y0, x1 - x0, y1 - y0, m_stride,
+                          HexMapPosition(m_origin.X() + x0, m_origin.Y() + y0));
+    }
+
+    /// 全要素に値を設定する
+    /// @param value [in] 値
+    void Fill(const T& value) const
+    {
+        for (int j(0); j < m_height; ++j) { std::fill(GetRow(j), GetRow(j) + m_width, value); }
+    }
+
+    /// 同じ大きさの参照から要素を書き写す
+    /// @param source [in] 書き写す元 この参照と重なっていないこと
+    void Assign(const HexMapView<T>& source) const
+    {
+        assert((source.GetWidth() == m_width) && (source.GetHeight() == m_height));
+        for (int j(0); j < m_height; ++j) { std::copy(source.GetRow(j), source.GetRow(j) + m_width, GetRow(j)); }
+    }
+
+    /// 元のマップでの位置取得
+    /// @param pos [in] この参照での位置
+    HexMapPosition ToSource(const HexMapPosition& pos) const
+    {
+        return HexMapPosition(pos.X() + m_origin.X(), pos.Y() + m_origin.Y());
+    }
+
+    /// この参照での位置取得
+    /// @param pos [in] 元のマップでの位置
+    HexMapPosition FromSource(const HexMapPosition& pos) const
+    {
+        return HexMapPosition(pos.X() - m_origin.X(), pos.Y() - m_origin.Y());
+    }
+
+    /// 幅取得
+    inline int GetWidth()  const { return m_width; }
+    /// 高さ取得
+    inline int GetHeight() const { return m_height; }
+    /// 大きさ取得
+    inline int Size() const { return m_width * m_height; }
+    /// 空であるか否か
+    inline bool Empty() const { return Size() == 0; }
+    /// 行の先頭の間隔取得
+    inline int GetStride() const { return m_stride; }
+    /// 元のマップでの原点の位置取得
+    inline const HexMapPosition& GetOrigin() const { return m_origin; }
+
+private:
+    T* m_data;               /// 要素の先頭
+    int m_width;             /// 幅
+    int m_height;            /// 高さ
+    int m_stride;            /// 行の先頭の間隔
+    HexMapPosition m_origin; /// 元のマップでの原点の位置
+};
+
+
+/// 参照するマップのその位置に侵入可能であるか否かを判定する
+/// @param map [in] ヘックスマップ参照
+/// @param pos [in] 位置
+inline bool IsEntriable(const HexMapView<HexChip>& map, const HexMapPosition& pos)
+{
+    if (pos.X() < 0) { return false; }
+    if (pos.Y() < 0) { return false; }
+    if (map.GetWidth() <= pos.X())  { return false; }
+    if (map.GetHeight() <= pos.Y()) { return false; }
+
+    return (map[pos] != HexChip::NoEntry);
+}
+
+/// 参照するマップで, 複数の開始地点から経路マップと距離マップを生成する
+/// @tparam InputIterator HexMapPositionを指す入力イテレータ
+/// @param map [in] ヘックスマップ参照
+/// @param first [in] 開始地点の先頭
+/// @param last [in] 開始地点の終端
+/// @param path_map [out] 経路マップ 各位置の一つ手前の位置 開始地点と到達できない位置は自身を指す
+/// @param distance_map [out] 最寄りの開始地点からの距離マップ 到達できない位置はPathDistanceUnreachable 侵入不可の位置はPathDistanceNoEntry
+/// @param scratch [in,out] 作業領域 確保済みの領域を使い回す
+/// @retval 到達できた位置の数
+template <int Width, int Height, class InputIterator>
+int GeneratePathMap(const HexMapView<HexChip>& map,
+                    InputIterator first,
+                    InputIterator last,
+                    HexMap<HexMapPosition, Width, Height>& path_map,
+                    HexMap<int, Width, Height>& distance_map,
+                    HexPathScratch& scratch)
+{
+    scratch.grid.Build(map);
+    return GeneratePathMapOnGrid(first, last, path_map, distance_map, scratch);
+}
+
+/// 参照するマップで経路マップと距離マップを生成する
+/// @param map [in] ヘックスマップ参照
+/// @param start [in] 開始地点
+/// @param path_map [out] 経路マップ 各位置の一つ手前の位置 到達できない位置は自身を指す
+/// @param distance_map [out] 距離マップ 到達できない位置はPathDistanceUnreachable 侵入不可の位置はPathDistanceNoEntry
+/// @retval 到達できた位置の数
+template <int Width, int Height>
+int GeneratePathMap(const HexMapView<HexChip>& map,
+                    const HexMapPosition& start,
+                    HexMap<HexMapPosition, Width, Height>& path_map,
+                    HexMap<int, Width, Height>& distance_map)
+{
+    HexPathScratch scratch;
+    return GeneratePathMap(map, &start, &start + 1, path_map, distance_map, scratch);
+}
+
+/// 参照するマップで, 複数の開始地点から経路マップと距離マップを参照先に生成する
+/// 大きなマップの一部を切り出した参照や, 呼び出し側が用意した領域に直接書き込む
+/// 位置はすべて参照の原点からの位置
+/// @tparam InputIterator HexMapPositionを指す入力イテレータ
+/// @param map [in] ヘックスマップ参照
+/// @param first [in] 開始地点の先頭
+/// @param last [in] 開始地点の終端
+/// @param path_map [out] 経路マップ mapと同じ大きさ 各位置の一つ手前の位置 開始地点と到達できない位置は自身を指す
+/// @param distance_map [out] 距離マップ mapと同じ大きさ 到達できない位置はPathDistanceUnreachable 侵入不可の位置はPathDistanceNoEntry
+/// @param scratch [in,out] 作業領域 確保済みの領域を使い回す
+/// @retval 到達できた位置の数
+template <class InputIterator>
+int GeneratePathMap(const HexMapView<HexChip>& map,
+                    InputIterator first,
+                    InputIterator last,
+                    HexMapSpan<HexMapPosition> path_map,
+                    HexMapSpan<int> distance_map,
+                    HexPathScratch& scratch)
+{
+    scratch.grid.Build(map);
+    return GeneratePathMapOnGrid(first, last, path_map, distance_map, scratch);
+}
+
+#endif
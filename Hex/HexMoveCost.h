@@ -0,0 +1,110 @@
+//
+//  HexMoveCost.h
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#ifndef Hex_HexMoveCost_h
+#define Hex_HexMoveCost_h
+
+#include "HexChip.h"
+
+#include <cassert>
+
+/// 地形タイプごとの移動コスト表
+/// 隣の位置へ移動するコストは移動先の地形タイプで決まる
+class HexMoveCost
+{
+public:
+    /// 侵入不可を表すコスト
+    enum { Impassable = -1 };
+
+    /// コンストラクタ
+    /// 既定値は 道:1 平地:2 森:3 沼:5 侵入不可:Impassable
+    HexMoveCost()
+    {
+        m_cost[HexChip::Standard] = 2;
+        m_cost[HexChip::NoEntry]  = Impassable;
+        m_cost[HexChip::Road]     = 1;
+        m_cost[HexChip::Forest]   = 3;
+        m_cost[HexChip::Swamp]    = 5;
+    }
+
+    /// 侵入不可以外の地形の移動コストがすべて等しいコスト表を取得
+    /// GeneratePathMapの歩数と同じ距離になる
+    /// @param cost [in] 移動コスト
+    /// @retval コスト表
+    static HexMoveCost Uniform(int cost = 1)
+    {
+        HexMoveCost uniform;
+        for (int i(0); i < HexChip::Count; ++i) {
+            if (i == HexChip::NoEntry) { continue; }
+            uniform.Set(static_cast<HexChip::Type>(i), cost);
+        }
+        return uniform;
+    }
+
+    /// 移動コスト取得
+    /// @param type [in] 地形タイプ
+    /// @retval 移動コスト 侵入不可ならばImpassable
+    int Get(HexChip::Type type) const
+    {
+        return m_cost[type];
+    }
+
+    /// 移動コスト設定
+    /// @param type [in] 地形タイプ
+    /// @param cost [in] 移動コスト 1以上 もしくはImpassable
+    void Set(HexChip::Type type, int cost)
+    {
+        assert((cost == Impassable) || (0 < cost));
+        m_cost[type] = cost;
+    }
+
+    /// 侵入可能であるか否か
+    /// @param type [in] 地形タイプ
+    /// @retval 侵入可能ならばtrue そうでなければfalse
+    bool IsPassable(HexChip::Type type) const
+    {
+        return m_cost[type] != Impassable;
+    }
+
+    /// 侵入可能な地形のうち最小の移動コストを取得
+    /// @retval 最小の移動コスト 侵入可能な地形が無ければ0
+    int GetMinCost() const
+    {
+        int min_cost(0);
+        for (int i(0); i < HexChip::Count; ++i) {
+            if (m_cost[i] == Impassable) { continue; }
+            if ((min_cost == 0) || (m_cost[i] < min_cost)) { min_cost = m_cost[i]; }
+        }
+        return min_cost;
+    }
+
+    /// 侵入可能な地形のうち最大の移動コストを取得
+    /// @retval 最大の移動コスト 侵入可能な地形が無ければ0
+    int GetMaxCost() const
+    {
+        int max_cost(0);
+        for (int i(0); i < HexChip::Count; ++i) {
+            if (max_cost < m_cost[i]) { max_cost = m_cost[i]; }
+        }
+        return max_cost;
+    }
+
+    /// 移動コスト取得
+    /// @param chip [in] 移動先のヘックスチップ
+    /// @retval 移動コスト 侵入不可ならばImpassable
+    int operator()(const HexChip& chip) const
+    {
+        return m_cost[chip.GetType()];
+    }
+
+private:
+    /// 地形タイプごとの移動コスト
+    int m_cost[HexChip::Count];
+};
+
+#endif
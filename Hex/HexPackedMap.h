@@ -0,0 +1,251 @@
+//
+//  HexPackedMap.h
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#ifndef Hex_HexPackedMap_h
+#define Hex_HexPackedMap_h
+
+#include "HexBitMap.h"
+#include "HexChip.h"
+#include "HexMapPosition.h"
+
+#include <cassert>
+#include <stdint.h>
+#include <vector>
+
+/// @class 地形タイプを詰めて持つヘックスマップ
+/// 一マスを Bits ビットで持ち, HexMap<HexChip>の一マス四バイトに比べて 32/Bits 分の一の大きさになる
+/// 各行を64ビットの語の並びで持ち, 行の先頭は必ず語の先頭に揃える
+/// 一語に 64/Bits マスを下位ビットから順に詰める
+/// Bitsビットに収まらない地形タイプは書き込まずに失敗を返す
+/// @tparam Bits 一マスのビット数 1, 2, 4のいずれか 1ならば平地と侵入不可だけを持てる
+template <int Bits>
+class HexPackedMap
+{
+    static_assert((Bits == 1) || (Bits == 2) || (Bits == 4), "Bits must be 1, 2 or 4");
+
+public:
+    /// 一語に詰めるマスの数
+    static const int CellsPerWord = 64 / Bits;
+
+    /// コンストラクタ
+    HexPackedMap()
+    :m_width(0)
+    ,m_height(0)
+    ,m_word_count(0)
+    ,m_words()
+    {}
+
+    /// コンストラクタ
+    /// 全て平地で生成する
+    /// @param width [in] 幅
+    /// @param height [in] 高さ
+    HexPackedMap(int width, int height)
+    :m_width(0)
+    ,m_height(0)
+    ,m_word_count(0)
+    ,m_words()
+    {
+        Resize(width, height);
+    }
+
+    /// 大きさ変更
+    /// 全て平地に戻る
+    /// @param width [in] 幅
+    /// @param height [in] 高さ
+    void Resize(int width, int height)
+    {
+        assert((0 <= width) && (0 <= height));
+        m_width      = width;
+        m_height     = height;
+        m_word_count = (width + CellsPerWord - 1) / CellsPerWord;
+        m_words.assign(static_cast<std::size_t>(m_word_count) * height, 0);
+    }
+
+    /// マップの地形を詰めて取り込む
+    /// 詰められない地形タイプがあれば失敗し, 全て平地に戻る
+    /// @tparam Map HexChipを保持するマップ
+    /// @param map [in] ヘックスマップ
+    /// @retval true 成功
+    /// @retval false Bitsビットに収まらない地形タイプがあった
+    template <class Map>
+    bool Assign(const Map& map)
+    {
+        Resize(map.GetWidth(), map.GetHeight());
+        for (int j(0); j < m_height; ++j) {
+            for (int i(0); i < m_width; ++i) {
+                const HexMapPosition pos(i, j);
+                if (! Set(pos, map[pos])) {
+                    Resize(m_width, m_height);
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /// 地形タイプを詰められるか否かを判定する
+    /// @param type [in] 地形タイプ
+    static bool CanHold(HexChip::Type type)
+    {
+        return (0 <= static_cast<int>(type)) && (static_cast<uint64_t>(type) <= s_mask);
+    }
+
+    /// 地形タイプ取得
+    /// 範囲の判定をしない
+    /// @param pos [in] 位置
+    HexChip::Type Get(const HexMapPosition& pos) const
+    {
+        return static_cast<HexChip::Type>((word(pos) >> shiftOf(pos)) & s_mask);
+    }
+
+    /// 要素取得
+    /// 詰めて持つので参照ではなく値を返す 書き込みはSetで行う
+    HexChip operator[](const HexMapPosition& pos) const { return HexChip(Get(pos)); }
+
+    /// 地形タイプ設定
+    /// 位置の範囲の判定をしない
+    /// Bitsビットに収まらない地形タイプは隣のマスを壊さないよう書き込まない
+    /// @param pos [in] 位置
+    /// @param type [in] 地形タイプ
+    /// @retval true 成功
+    /// @retval false 地形タイプがBitsビットに収まらない
+    bool Set(const HexMapPosition& pos, HexChip::Type type)
+    {
+        if (! CanHold(type)) { return false; }
+        const int shift = shiftOf(pos);
+        uint64_t& w = word(pos);
+        w = (w & ~(s_mask << shift)) | (static_cast<uint64_t>(type) << shift);
+        return true;
+    }
+
+    /// 一行分の語の先頭を取得
+    /// 幅を超えるマスのビットは0のままにしておくこと
+    /// @param y [in] 行
+    uint64_t*       GetRow(int y)       { return &m_words[static_cast<std::size_t>(m_word_count) * y]; }
+    const uint64_t* GetRow(int y) const { return &m_words[static_cast<std::size_t>(m_word_count) * y]; }
+
+    /// 一行分の語数取得
+    int GetWordCount() const { return m_word_count; }
+
+    /// 確保しているバイト数を取得
+    std::size_t GetByteSize() const { return m_words.size() * sizeof(uint64_t); }
+
+    /// 幅取得
+    int GetWidth() const { return m_width; }
+    /// 高さ取得
+    int GetHeight() const { return m_height; }
+    /// 大きさ取得
+    int Size() const { return m_width * m_height; }
+
+private:
+    /// 位置を含む語を取得
+    uint64_t&       word(const HexMapPosition& pos)       { return GetRow(pos.Y())[pos.X() / CellsPerWord]; }
+    const uint64_t& word(const HexMapPosition& pos) const { return GetRow(pos.Y())[pos.X() / CellsPerWord]; }
+
+    /// 語の中の位置のビット位置を取得
+    static int shiftOf(const HexMapPosition& pos) { return (pos.X() % CellsPerWord) * Bits; }
+
+    /// 一マス分のビット
+    static const uint64_t s_mask = (uint64_t(1) << Bits) - 1;
+
+    int m_width;      /// 幅
+    int m_height;     /// 高さ
+    int m_word_count; /// 一行分の語数
+
+    /// 各行の語
+    std::vector<uint64_t> m_words;
+};
+
+template <int Bits> const int      HexPackedMap<Bits>::CellsPerWord;
+template <int Bits> const uint64_t HexPackedMap<Bits>::s_mask;
+
+/// 詰めた地形の一語から侵入可能なマスのビットを取り出す
+/// 各マスを侵入不可と比べ, 一致しないマスを1とするビットを下位から詰める
+/// @tparam Bits 一マスのビット数
+/// @param packed [in] 詰めた地形の一語
+/// @retval 64/Bits ビットの侵入可否
+template <int Bits>
+inline uint64_t ExtractPassableBits(uint64_t packed);
+
+template <>
+inline uint64_t ExtractPassableBits<1>(uint64_t packed)
+{
+    // 1ビットでは侵入不可が1
+    return ~packed;
+}
+
+template <>
+inline uint64_t ExtractPassableBits<2>(uint64_t packed)
+{
+    uint64_t x = packed ^ (UINT64_C(0x5555555555555555) * HexChip::NoEntry);
+    x = (x | (x >> 1))  & UINT64_C(0x5555555555555555);
+    x = (x | (x >> 1))  & UINT64_C(0x3333333333333333);
+    x = (x | (x >> 2))  & UINT64_C(0x0F0F0F0F0F0F0F0F);
+    x = (x | (x >> 4))  & UINT64_C(0x00FF00FF00FF00FF);
+    x = (x | (x >> 8))  & UINT64_C(0x0000FFFF0000FFFF);
+    x = (x | (x >> 16)) & UINT64_C(0x00000000FFFFFFFF);
+    return x;
+}
+
+template <>
+inline uint64_t ExtractPassableBits<4>(uint64_t packed)
+{
+    uint64_t x = packed ^ (UINT64_C(0x1111111111111111) * HexChip::NoEntry);
+    x = (x | (x >> 1) | (x >> 2) | (x >> 3)) & UINT64_C(0x1111111111111111);
+    x = (x | (x >> 3))  & UINT64_C(0x0303030303030303);
+    x = (x | (x >> 6))  & UINT64_C(0x000F000F000F000F);
+    x = (x | (x >> 12)) & UINT64_C(0x000000FF000000FF);
+    x = (x | (x >> 24)) & UINT64_C(0x000000000000FFFF);
+    return x;
+}
+
+/// 詰めた地形から侵入可否の層を作る
+/// 一マスずつではなく語単位で変換する
+/// @param map [in] 地形を詰めたマップ
+/// @param passable [out] 侵入可能な位置のビットが立った層
+template <int Bits>
+void BuildPassableBitMap(const HexPackedMap<Bits>& map, HexBitMap& passable)
+{
+    passable.Resize(map.GetWidth(), map.GetHeight());
+
+    const int cells = HexPackedMap<Bits>::CellsPerWord;
+    const int tail  = map.GetWidth() % 64;
+    const uint64_t tail_mask = (tail == 0) ? ~uint64_t(0) : ((uint64_t(1) << tail) - 1);
+    for (int j(0); j < map.GetHeight(); ++j) {
+        const uint64_t* packed = map.GetRow(j);
+        uint64_t* bits = passable.GetRow(j);
+        for (int w(0); w < passable.GetWordCount(); ++w) {
+            uint64_t value(0);
+            for (int k(0); k < Bits; ++k) {
+                const int source = w * Bits + k;
+                if (map.GetWordCount() <= source) { break; }
+                const uint64_t part = ExtractPassableBits<Bits>(packed[source]);
+                value |= (cells == 64) ? part : ((part & ((uint64_t(1) << cells) - 1)) << (k * cells));
+            }
+            bits[w] = value;
+        }
+        // 幅を超えるビットを落とす
+        if (0 < passable.GetWordCount()) { bits[passable.GetWordCount() - 1] &= tail_mask; }
+    }
+}
+
+/// 地形を詰めたマップのその位置に侵入可能であるか否かを判定する
+/// @param map [in] 地形を詰めたマップ
+/// @param pos [in] 位置
+template <int Bits>
+bool IsEntriable(const HexPackedMap<Bits>& map, const HexMapPosition& pos)
+{
+    if (pos.X() < 0) { return false; }
+    if (pos.Y() < 0) { return false; }
+    if (map.GetWidth() <= pos.X())  { return false; }
+    if (map.GetHeight() <= pos.Y()) { return false; }
+
+    return (map.Get(pos) != HexChip::NoEntry);
+}
+
+#endif
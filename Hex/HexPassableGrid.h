@@ -0,0 +1,138 @@
+//
+//  HexPassableGrid.h
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#ifndef Hex_HexPassableGrid_h
+#define Hex_HexPassableGrid_h
+
+#include "HexBitMap.h"
+#include "HexChip.h"
+#include "HexMapPosition.h"
+
+#include <vector>
+
+/// @class 番兵付きの侵入可否グリッド
+/// マップの周囲一マスを侵入不可の番兵で囲んだ配置で, 侵入可否を一バイトずつ持つ
+/// マップ内の位置の隣は必ずグリッド内に収まるので, 範囲の判定なしに引ける
+/// 隣の添字は 添字 + 差分[行の偶奇][隣指定] で求まる
+class HexPassableGrid
+{
+public:
+    /// コンストラクタ
+    HexPassableGrid()
+    :m_width(0)
+    ,m_height(0)
+    ,m_stride(0)
+    ,m_cells()
+    {
+        buildDelta();
+    }
+
+    /// ヘックスマップから構築する
+    /// 確保済みの領域は使い回す
+    /// @tparam Map HexChipを保持するマップ
+    /// @param map [in] ヘックスマップ
+    template <class Map>
+    void Build(const Map& map)
+    {
+        resize(map.GetWidth(), map.GetHeight());
+
+        for (int j(0); j < m_height; ++j) {
+            unsigned char* row = &m_cells[IndexOf(HexMapPosition(0, j))];
+            for (int i(0); i < m_width; ++i) {
+                row[i] = (map[HexMapPosition(i, j)] != HexChip::NoEntry) ? 1 : 0;
+            }
+        }
+    }
+
+    /// 侵入可否の層から構築する
+    /// 確保済みの領域は使い回す
+    /// @param passable [in] 侵入可能な位置のビットが立った層
+    void Build(const HexBitMap& passable)
+    {
+        resize(passable.GetWidth(), passable.GetHeight());
+
+        for (int j(0); j < m_height; ++j) {
+            unsigned char* row = &m_cells[IndexOf(HexMapPosition(0, j))];
+            const uint64_t* bits = passable.GetRow(j);
+            for (int i(0); i < m_width; ++i) {
+                row[i] = static_cast<unsigned char>((bits[i / 64] >> (i % 64)) & 1);
+            }
+        }
+    }
+
+    /// 位置からグリッドの添字を取得
+    /// @param pos [in] 位置 マップの外側一マスまで
+    /// @retval 添字
+    int IndexOf(const HexMapPosition& pos) const
+    {
+        return (pos.X() + 1) + m_stride * (pos.Y() + 1);
+    }
+
+    /// 隣の添字への差分表を取得
+    /// @param y [in] 行 偶奇だけを見る
+    /// @retval 隣指定ごとの差分
+    const int* GetNeighborDelta(int y) const
+    {
+        return m_delta[y & 1];
+    }
+
+    /// 侵入可能であるか否か
+    /// 範囲の判定をしない
+    /// @param index [in] 添字
+    bool IsEntriable(int index) const { return m_cells[index] != 0; }
+
+    /// 侵入可能であるか否か
+    /// 範囲の判定をしない
+    /// @param pos [in] 位置 マップの外側一マスまで
+    bool IsEntriable(const HexMapPosition& pos) const { return IsEntriable(IndexOf(pos)); }
+
+    /// 侵入不可にする
+    /// 探索で訪問済みの印として使う
+    /// @param index [in] 添字
+    void Close(int index) { m_cells[index] = 0; }
+
+    /// 幅取得
+    int GetWidth() const { return m_width; }
+    /// 高さ取得
+    int GetHeight() const { return m_height; }
+    /// 番兵を含む一行の要素数取得
+    int GetStride() const { return m_stride; }
+
+private:
+    /// 大きさを変えて全て侵入不可にする
+    void resize(int width, int height)
+    {
+        m_width  = width;
+        m_height = height;
+        m_stride = m_width + 2;
+        m_cells.assign(m_stride * (m_height + 2), 0);
+        buildDelta();
+    }
+
+    /// 隣の添字への差分表を作る
+    void buildDelta()
+    {
+        for (int parity(0); parity < 2; ++parity) {
+            for (int n(0); n < HexMapPosition::NeighborCount; ++n) {
+                m_delta[parity][n] = HexMapPosition::s_neighbor_x[parity][n] + m_stride * HexMapPosition::s_neighbor_y[n];
+            }
+        }
+    }
+
+    int m_width;  /// 幅
+    int m_height; /// 高さ
+    int m_stride; /// 番兵を含む一行の要素数
+
+    /// 隣の添字への差分 [行の偶奇][隣指定]
+    int m_delta[2][HexMapPosition::NeighborCount];
+
+    /// 侵入可否 番兵は侵入不可
+    std::vector<unsigned char> m_cells;
+};
+
+#endif
@@ -0,0 +1,126 @@
+//
+//  HexPathExecutor.cpp
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#include "HexPathExecutor.h"
+
+#include <algorithm>
+
+/// コンストラクタ
+HexPathExecutor::HexPathExecutor(int worker_count)
+:m_workers()
+,m_threads()
+,m_mutex()
+,m_wake()
+,m_done()
+,m_queued(0)
+,m_pending(0)
+,m_next(0)
+,m_stop(false)
+{
+    if (worker_count <= 0) { worker_count = static_cast<int>(std::thread::hardware_concurrency()); }
+    if (worker_count <= 0) { worker_count = 1; }
+
+    for (int i(0); i < worker_count; ++i) { m_workers.push_back(new Worker()); }
+    for (int i(0); i < worker_count; ++i) { m_threads.push_back(std::thread(&HexPathExecutor::run, this, i)); }
+}
+
+/// デストラクタ
+HexPathExecutor::~HexPathExecutor()
+{
+    Wait();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (std::size_t i(0); i < m_threads.size(); ++i) { m_threads[i].join(); }
+    for (std::size_t i(0); i < m_workers.size(); ++i) { delete m_workers[i]; }
+}
+
+/// 作業を積む
+void HexPathExecutor::Submit(const Task& task)
+{
+    // 作業を終えたワーカーが数を減らす前に数えておく
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_pending;
+        ++m_queued;
+    }
+    Worker& worker = *m_workers[m_next++ % m_workers.size()];
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(task);
+    }
+    m_wake.notify_one();
+}
+
+/// 積んだ作業がすべて終わるまで待つ
+void HexPathExecutor::Wait()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_pending != 0) { m_done.wait(lock); }
+}
+
+/// 範囲を分割して並列に実行し, 終わるまで待つ
+void HexPathExecutor::ParallelFor(int count, int grain, const RangeTask& task)
+{
+    if (grain <= 0) { grain = 1; }
+    for (int begin(0); begin < count; begin += grain) {
+        const int end = std::min(count, begin + grain);
+        Submit([=](int worker) { task(begin, end, worker); });
+    }
+    Wait();
+}
+
+/// ワーカーの処理
+void HexPathExecutor::run(int index)
+{
+    for (;;) {
+        Task task;
+        if (pop(index, task) || steal(index, task)) {
+            task(index);
+            if (--m_pending == 0) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_done.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while ((! m_stop) && (m_queued == 0)) { m_wake.wait(lock); }
+        if (m_stop && (m_queued == 0)) { return; }
+    }
+}
+
+/// 自分のキューの末尾から作業を取り出す
+bool HexPathExecutor::pop(int index, Task& task)
+{
+    Worker& worker = *m_workers[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.tasks.empty()) { return false; }
+    task = worker.tasks.back();
+    worker.tasks.pop_back();
+    --m_queued;
+    return true;
+}
+
+/// 他のワーカーのキューの先頭から作業を盗む
+bool HexPathExecutor::steal(int index, Task& task)
+{
+    const int count = GetWorkerCount();
+    for (int i(1); i < count; ++i) {
+        Worker& victim = *m_workers[(index + i) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.tasks.empty()) { continue; }
+        task = victim.tasks.front();
+        victim.tasks.pop_front();
+        --m_queued;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,90 @@
+//
+//  HexPathExecutor.h
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#ifndef Hex_HexPathExecutor_h
+#define Hex_HexPathExecutor_h
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @class 経路探索の実行スレッドプール
+/// ワーカーごとに作業キューを持ち, 自分のキューが空になると他のワーカーのキューから盗む
+/// Wait()とParallelFor()はワーカーの外のスレッドから呼ぶこと
+class HexPathExecutor
+{
+public:
+    /// 作業 引数は実行するワーカーの番号
+    typedef std::function<void(int)> Task;
+
+    /// 範囲作業 引数は範囲の先頭, 終端, 実行するワーカーの番号
+    typedef std::function<void(int, int, int)> RangeTask;
+
+    /// コンストラクタ
+    /// @param worker_count [in] ワーカー数 0ならばハードウェアのスレッド数
+    explicit HexPathExecutor(int worker_count = 0);
+
+    /// デストラクタ
+    /// 積まれた作業をすべて終えてからワーカーを止める
+    ~HexPathExecutor();
+
+    /// ワーカー数取得
+    int GetWorkerCount() const { return static_cast<int>(m_workers.size()); }
+
+    /// 作業を積む
+    /// @param task [in] 作業
+    void Submit(const Task& task);
+
+    /// 積んだ作業がすべて終わるまで待つ
+    void Wait();
+
+    /// 範囲を分割して並列に実行し, 終わるまで待つ
+    /// @param count [in] 範囲の大きさ
+    /// @param grain [in] 一つの作業で受け持つ大きさ
+    /// @param task [in] 範囲作業
+    void ParallelFor(int count, int grain, const RangeTask& task);
+
+private:
+    /// ワーカーごとの作業キュー
+    struct Worker
+    {
+        std::mutex       mutex; /// キューの排他
+        std::deque<Task> tasks; /// 作業キュー
+    };
+
+    /// ワーカーの処理
+    /// @param index [in] ワーカーの番号
+    void run(int index);
+
+    /// 自分のキューの末尾から作業を取り出す
+    bool pop(int index, Task& task);
+
+    /// 他のワーカーのキューの先頭から作業を盗む
+    bool steal(int index, Task& task);
+
+    // コピー禁止
+    HexPathExecutor(const HexPathExecutor&);
+    HexPathExecutor& operator=(const HexPathExecutor&);
+
+    std::vector<Worker*>     m_workers; /// ワーカー
+    std::vector<std::thread> m_threads; /// スレッド
+
+    std::mutex              m_mutex;  /// 待機の排他
+    std::condition_variable m_wake;   /// 作業が積まれた通知
+    std::condition_variable m_done;   /// 作業がすべて終わった通知
+    std::atomic<int>        m_queued; /// キューにある作業の数
+    std::atomic<int>        m_pending;/// 終わっていない作業の数
+    std::atomic<unsigned>   m_next;   /// 次に作業を積むワーカー
+    bool                    m_stop;   /// 停止要求
+};
+
+#endif
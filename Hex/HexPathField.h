@@ -0,0 +1,184 @@
+//
+//  HexPathField.h
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#ifndef Hex_HexPathField_h
+#define Hex_HexPathField_h
+
+#include "HexMap.h"
+
+#include <stdint.h>
+#include <vector>
+
+/// 方向マップの値 進む方向が無いことを表す
+enum { DirectionNone = -1 };
+
+/// 経路マップから方向マップを生成する
+/// 各位置から経路マップの一つ手前の位置へ進む隣指定を求める
+/// 目標地点の集合から生成した経路マップを与えれば, 最寄りの目標地点へ向かう流れの場になる
+/// @param path_map [in] 経路マップ
+/// @param direction_map [out] 方向マップ 値はHexMapPosition::Neighbor 進む方向が無い位置はDirectionNone
+template <int Width, int Height>
+void GenerateDirectionMap(const HexMap<HexMapPosition, Width, Height>& path_map,
+                          HexMap<int, Width, Height>& direction_map)
+{
+    assert((direction_map.GetWidth() == path_map.GetWidth()) && (direction_map.GetHeight() == path_map.GetHeight()));
+
+    for (int j(0); j < path_map.GetHeight(); ++j) {
+        for (int i(0); i < path_map.GetWidth(); ++i) {
+            const HexMapPosition pos(i, j);
+            const HexMapPosition& parent = path_map[pos];
+            int direction = DirectionNone;
+            for (int n(0); (parent != pos) && (n < HexMapPosition::NeighborCount); ++n) {
+                if (pos.GetNeighbor(static_cast<HexMapPosition::Neighbor>(n)) == parent) { direction = n; }
+            }
+            direction_map[pos] = direction;
+        }
+    }
+}
+
+/// @class 複数の距離マップの一括生成
+/// 最大64個の開始地点について, ビットごとに別々の幅優先探索を割り当てて同時に進める
+/// 各位置の隣を調べるのは段ごとに一度だけなので, 開始地点の数が増えても走査の回数は増えない
+/// 作業領域は生成のたびに再利用する
+/// @tparam Width マップ幅
+/// @tparam Height マップ高さ
+template <int Width, int Height>
+class HexPathFieldBatch
+{
+public:
+    /// 一度に同時に進める開始地点の数
+    enum { LaneCount = 64 };
+
+    /// コンストラクタ
+    HexPathFieldBatch()
+    :m_starts()
+    ,m_seen()
+    ,m_frontier()
+    ,m_next()
+    ,m_active()
+    ,m_next_active()
+    {}
+
+    /// 開始地点ごとの距離マップを生成する
+    /// @tparam InputIterator HexMapPositionを指す入力イテレータ
+    /// @param map [in] ヘックスマップ
+    /// @param first [in] 開始地点の先頭
+    /// @param last [in] 開始地点の終端
+    /// @param fields [out] 開始地点ごとの距離マップ 開始地点の数に合わせて大きさを変える
+    ///        値はGeneratePathMapの距離マップと同じ
+    template <class InputIterator>
+    void Generate(const HexMap<HexChip, Width, Height>& map,
+                  InputIterator first,
+                  InputIterator last,
+                  std::vector<HexMap<int, Width, Height> >& fields)
+    {
+        m_starts.assign(first, last);
+        const int field_count = static_cast<int>(m_starts.size());
+        if ((! fields.empty()) && (fields[0].GetWidth() != map.GetWidth() || fields[0].GetHeight() != map.GetHeight())) {
+            fields.clear();
+        }
+        if (static_cast<int>(fields.size()) != field_count) {
+            fields.resize(field_count, HexMap<int, Width, Height>(map.GetWidth(), map.GetHeight()));
+        }
+
+        m_seen.resize(map.Size());
+        m_frontier.resize(map.Size());
+        m_next.resize(map.Size());
+
+        for (int base(0); base < field_count; base += LaneCount) {
+            const int lane_count = std::min<int>(LaneCount, field_count - base);
+            generateLanes(map, base, lane_count, fields);
+        }
+    }
+
+private:
+    /// 位置から作業領域の添字を取得
+    static int indexOf(const HexMap<HexChip, Width, Height>& map, const HexMapPosition& pos)
+    {
+        return pos.X() + map.GetWidth() * pos.Y();
+    }
+
+    /// 開始地点の一部をまとめて生成する
+    /// @param map [in] ヘックスマップ
+    /// @param base [in] 先頭の開始地点の番号
+    /// @param lane_count [in] 同時に進める開始地点の数
+    /// @param fields [out] 開始地点ごとの距離マップ
+    void generateLanes(const HexMap<HexChip, Width, Height>& map,
+                       int base,
+                       int lane_count,
+                       std::vector<HexMap<int, Width, Height> >& fields)
+    {
+        std::fill(m_seen.begin(), m_seen.end(), 0);
+        m_active.clear();
+
+        for (int k(0); k < lane_count; ++k) {
+            HexMap<int, Width, Height>& field = fields[base + k];
+            for (int j(0); j < map.GetHeight(); ++j) {
+                for (int i(0); i < map.GetWidth(); ++i) {
+                    const HexMapPosition pos(i, j);
+                    field[pos] = (map[pos] == HexChip::NoEntry) ? PathDistanceNoEntry : PathDistanceUnreachable;
+                }
+            }
+
+            /// 開始地点設定
+            const HexMapPosition& start = m_starts[base + k];
+            if (! IsEntriable(map, start)) { continue; }
+            const int index = indexOf(map, start);
+            if (m_seen[index] == 0) {
+                m_frontier[index] = 0;
+                m_active.push_back(start);
+            }
+            m_seen[index]     |= (uint64_t(1) << k);
+            m_frontier[index] |= (uint64_t(1) << k);
+            field[start] = 0;
+        }
+
+        for (int distance(1); ! m_active.empty(); ++distance) {
+            m_next_active.clear();
+
+            // 前線の各位置から, まだ届いていない探索のビットだけを隣へ伝える
+            for (std::size_t a(0); a < m_active.size(); ++a) {
+                const HexMapPosition pivot = m_active[a];
+                const uint64_t lanes = m_frontier[indexOf(map, pivot)];
+                for (int n(0); n < HexMapPosition::NeighborCount; ++n) {
+                    const HexMapPosition candidate = pivot.GetNeighbor(static_cast<HexMapPosition::Neighbor>(n));
+                    if (! IsEntriable(map, candidate)) { continue; }
+
+                    const int index = indexOf(map, candidate);
+                    const uint64_t arrived = lanes & ~m_seen[index];
+                    if (arrived == 0) { continue; }
+                    if (m_next[index] == 0) { m_next_active.push_back(candidate); }
+                    m_next[index] |= arrived;
+                }
+            }
+
+            // 届いた探索のビットを確定して次の前線にする
+            for (std::size_t a(0); a < m_next_active.size(); ++a) {
+                const HexMapPosition pos = m_next_active[a];
+                const int index = indexOf(map, pos);
+                uint64_t arrived = m_next[index];
+                m_next[index]     = 0;
+                m_seen[index]    |= arrived;
+                m_frontier[index] = arrived;
+                for (int k(0); arrived != 0; ++k, arrived >>= 1) {
+                    if (arrived & 1) { fields[base + k][pos] = distance; }
+                }
+            }
+            m_active.swap(m_next_active);
+        }
+    }
+
+    std::vector<HexMapPosition> m_starts;      /// 開始地点
+    std::vector<uint64_t>       m_seen;        /// 位置ごとの到達済みの探索
+    std::vector<uint64_t>       m_frontier;    /// 位置ごとの前線にいる探索
+    std::vector<uint64_t>       m_next;        /// 位置ごとの次の段で届く探索
+    std::vector<HexMapPosition> m_active;      /// 前線の位置
+    std::vector<HexMapPosition> m_next_active; /// 次の段の前線の位置
+};
+
+#endif
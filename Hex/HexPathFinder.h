@@ -0,0 +1,161 @@
+//
+//  HexPathFinder.h
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#ifndef Hex_HexPathFinder_h
+#define Hex_HexPathFinder_h
+
+#include "HexAxialPosition.h"
+#include "HexMap.h"
+#include "HexMoveCost.h"
+#include "HexRadixHeap.h"
+
+/// 推定値なし
+/// A*に渡すとダイクストラ法と同じ探索になる
+struct HexZeroHeuristic
+{
+    int operator()(const HexMapPosition&) const { return 0; }
+};
+
+/// ヘックス距離による推定値
+/// 最小の移動コストを掛けるので実際のコストを超えない
+struct HexDistanceHeuristic
+{
+    /// コンストラクタ
+    /// @param goal [in] 目標地点
+    /// @param cost [in] 移動コスト表
+    HexDistanceHeuristic(const HexMapPosition& goal, const HexMoveCost& cost)
+    :m_goal(HexAxialPosition::FromOffset(goal))
+    ,m_min_cost(cost.GetMinCost())
+    {}
+
+    int operator()(const HexMapPosition& pos) const
+    {
+        return HexAxialPosition::Distance(HexAxialPosition::FromOffset(pos), m_goal) * m_min_cost;
+    }
+
+    HexAxialPosition m_goal; /// 目標地点
+    int m_min_cost;          /// 最小の移動コスト
+};
+
+/// 移動コストを考慮してマップのその位置に侵入可能であるか否かを判定する
+/// @param map [in] ヘックスマップ
+/// @param cost [in] 移動コスト表
+/// @param pos [in] 位置
+template <int Width, int Height>
+bool IsEntriable(const HexMap<HexChip, Width, Height>& map, const HexMoveCost& cost, const HexMapPosition& pos)
+{
+    if (pos.X() < 0) { return false; }
+    if (pos.Y() < 0) { return false; }
+    if (map.GetWidth() <= pos.X())  { return false; }
+    if (map.GetHeight() <= pos.Y()) { return false; }
+
+    return cost.IsPassable(map[pos].GetType());
+}
+
+/// 移動コストを考慮した経路探索 (A*)
+/// 推定値が無矛盾であれば, 目標地点を取り出した時点で最短経路が確定する
+/// @param map [in] ヘックスマップ
+/// @param cost [in] 移動コスト表
+/// @param start [in] 開始地点
+/// @param goal [in] 目標地点 NULLならばマップ全体を探索する
+/// @param heuristic [in] 目標地点までのコストの推定値
+/// @param path_map [out] 経路マップ 各位置の一つ手前の位置 到達していない位置は自身を指す
+/// @param distance_map [out] コストマップ 到達していない位置はPathDistanceUnreachable 侵入不可の位置はPathDistanceNoEntry
+/// @retval 目標地点までのコスト 到達できなければPathDistanceUnreachable 目標地点がNULLならば到達できた位置の数
+template <int Width, int Height, class Heuristic>
+int SearchPathMap(const HexMap<HexChip, Width, Height>& map,
+                  const HexMoveCost& cost,
+                  const HexMapPosition& start,
+                  const HexMapPosition* goal,
+                  const Heuristic& heuristic,
+                  HexMap<HexMapPosition, Width, Height>& path_map,
+                  HexMap<int, Width, Height>& distance_map)
+{
+    assert((path_map.GetWidth() == map.GetWidth()) && (path_map.GetHeight() == map.GetHeight()));
+    assert((distance_map.GetWidth() == map.GetWidth()) && (distance_map.GetHeight() == map.GetHeight()));
+
+    for (int j(0); j < map.GetHeight(); ++j) {
+        for (int i(0); i < map.GetWidth(); ++i) {
+            const HexMapPosition pos(i, j);
+            path_map[pos]     = pos;
+            distance_map[pos] = cost.IsPassable(map[pos].GetType()) ? PathDistanceUnreachable : PathDistanceNoEntry;
+        }
+    }
+    if (! IsEntriable(map, cost, start)) { return (goal != NULL) ? PathDistanceUnreachable : 0; }
+
+    HexRadixHeap<HexMapPosition> open;
+    int reached(0);
+
+    /// 開始地点設定
+    distance_map[start] = 0;
+    open.Push(heuristic(start), start);
+
+    while (! open.Empty()) {
+        const typename HexRadixHeap<HexMapPosition>::Entry entry = open.Pop();
+        const HexMapPosition pivot = entry.second;
+        const int current = distance_map[pivot];
+
+        // より小さいコストで積み直された古い要素は読み飛ばす
+        if (static_cast<int>(entry.first) != current + heuristic(pivot)) { continue; }
+        ++reached;
+        if ((goal != NULL) && (pivot == *goal)) { return current; }
+
+        for (int i(0); i < HexMapPosition::NeighborCount; ++i) {
+            const HexMapPosition candidate = pivot.GetNeighbor(static_cast<HexMapPosition::Neighbor>(i));
+            if (! IsEntriable(map, cost, candidate)) { continue; }
+
+            const int next = current + cost(map[candidate]);
+            const int known = distance_map[candidate];
+            if ((known != PathDistanceUnreachable) && (known <= next)) { continue; }
+
+            distance_map[candidate] = next;
+            path_map[candidate]     = pivot;
+            open.Push(next + heuristic(candidate), candidate);
+        }
+    }
+    return (goal != NULL) ? PathDistanceUnreachable : reached;
+}
+
+/// 移動コストを考慮した経路マップとコストマップを生成する (ダイクストラ法)
+/// @param map [in] ヘックスマップ
+/// @param cost [in] 移動コスト表
+/// @param start [in] 開始地点
+/// @param path_map [out] 経路マップ 到達できない位置は自身を指す
+/// @param distance_map [out] コストマップ 到達できない位置はPathDistanceUnreachable 侵入不可の位置はPathDistanceNoEntry
+/// @retval 到達できた位置の数
+template <int Width, int Height>
+int GenerateCostMap(const HexMap<HexChip, Width, Height>& map,
+                    const HexMoveCost& cost,
+                    const HexMapPosition& start,
+                    HexMap<HexMapPosition, Width, Height>& path_map,
+                    HexMap<int, Width, Height>& distance_map)
+{
+    return SearchPathMap(map, cost, start, static_cast<const HexMapPosition*>(NULL), HexZeroHeuristic(), path_map, distance_map);
+}
+
+/// 二点間の経路を探索する (A*)
+/// ヘックス距離を推定値とするので, 目標地点の方向へ優先して探索が進む
+/// @param map [in] ヘックスマップ
+/// @param cost [in] 移動コスト表
+/// @param start [in] 開始地点
+/// @param goal [in] 目標地点
+/// @param path_map [out] 経路マップ 目標地点から辿ると開始地点に至る
+/// @param distance_map [out] コストマップ 探索した位置のみ有効
+/// @retval 目標地点までのコスト 到達できなければPathDistanceUnreachable
+template <int Width, int Height>
+int FindPath(const HexMap<HexChip, Width, Height>& map,
+             const HexMoveCost& cost,
+             const HexMapPosition& start,
+             const HexMapPosition& goal,
+             HexMap<HexMapPosition, Width, Height>& path_map,
+             HexMap<int, Width, Height>& distance_map)
+{
+    return SearchPathMap(map, cost, start, &goal, HexDistanceHeuristic(goal, cost), path_map, distance_map);
+}
+
+#endif
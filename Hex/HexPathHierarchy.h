@@ -0,0 +1,608 @@
+//
+//  HexPathHierarchy.h
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#ifndef Hex_HexPathHierarchy_h
+#define Hex_HexPathHierarchy_h
+
+#include "HexAxialPosition.h"
+#include "HexMap.h"
+#include "HexMoveCost.h"
+#include "HexRadixHeap.h"
+
+#include <algorithm>
+#include <cassert>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <stdint.h>
+
+/// @class 階層的経路探索 (HPA*)
+/// マップを正方形のクラスタに分け, 隣り合うクラスタの境界で連続して通れる区間ごとに出入口を置く
+/// 出入口を頂点, クラスタ内の出入口間の最小コストとクラスタをまたぐ一歩を辺とする抽象グラフを事前に作り,
+/// 問い合わせは抽象グラフ上のA*で大まかな経路を求めてから, クラスタ内の区間をクラスタ内の探索で詳細化する
+/// 出入口を区間ごとに一つか両端の二つに絞るので, 経路は最短とは限らないが最短に近い
+/// 地形を変えたらそのクラスタだけを作り直せばよい
+/// @tparam Width マップ幅
+/// @tparam Height マップ高さ
+template <int Width, int Height>
+class HexPathHierarchy
+{
+public:
+    /// 既定のクラスタの一辺の長さ
+    static const int DefaultClusterSize = 16;
+
+    /// コンストラクタ
+    HexPathHierarchy()
+    :m_cost()
+    ,m_cluster_size(0)
+    ,m_width(0)
+    ,m_height(0)
+    ,m_columns(0)
+    ,m_rows(0)
+    ,m_min_cost(0)
+    ,m_clusters()
+    ,m_generation(0)
+    {}
+
+    /// 抽象グラフを構築する
+    /// @param map [in] ヘックスマップ
+    /// @param cost [in] 移動コスト表
+    /// @param cluster_size [in] クラスタの一辺の長さ
+    void Build(const HexMap<HexChip, Width, Height>& map, const HexMoveCost& cost, int cluster_size = DefaultClusterSize)
+    {
+        assert(0 < cluster_size);
+        m_cost         = cost;
+        m_cluster_size = cluster_size;
+        m_width        = map.GetWidth();
+        m_height       = map.GetHeight();
+        m_columns      = (m_width + cluster_size - 1) / cluster_size;
+        m_rows         = (m_height + cluster_size - 1) / cluster_size;
+        m_clusters.assign(m_columns * m_rows, Cluster());
+        m_local_distance.resize(cluster_size * cluster_size);
+        m_local_parent.resize(cluster_size * cluster_size);
+
+        // 移動コスト表の最小値よりマップにある地形の最小値の方が推定値が実際のコストに近い
+        m_min_cost = 0;
+        for (int j(0); j < m_height; ++j) {
+            for (int i(0); i < m_width; ++i) { updateMinCost(map[HexMapPosition(i, j)]); }
+        }
+
+        for (int k(0); k < GetClusterCount(); ++k) { buildNodes(map, k); }
+        for (int k(0); k < GetClusterCount(); ++k) { buildIntraEdges(map, k); }
+        for (int k(0); k < GetClusterCount(); ++k) { buildInterEdges(map, k); }
+    }
+
+    /// 地形が変わった位置を含むクラスタを作り直す
+    /// 出入口は隣のクラスタと共有するので, 隣のクラスタの出入口とクラスタ内の辺も作り直し,
+    /// その隣のクラスタからの辺を繋ぎ直す
+    /// 複数の位置を変えたときは, 全て変えてから位置ごとに呼べばよい 全て呼び終えれば一つずつ変えたときと同じになる
+    /// @param map [in] 地形を変更した後のヘックスマップ
+    /// @param pos [in] 地形を変更した位置 マップの外ならば何もしない
+    void RebuildCluster(const HexMap<HexChip, Width, Height>& map, const HexMapPosition& pos)
+    {
+        assert((map.GetWidth() == m_width) && (map.GetHeight() == m_height));
+        if ((pos.X() < 0) || (pos.Y() < 0) || (m_width <= pos.X()) || (m_height <= pos.Y())) { return; }
+        const int column = pos.X() / m_cluster_size;
+        const int row    = pos.Y() / m_cluster_size;
+        // 最小の移動コストは下がることはあっても上げない 推定値は小さい分には正しい
+        updateMinCost(map[pos]);
+
+        forEachCluster(column, row, 1, &HexPathHierarchy::buildNodes, map);
+        forEachCluster(column, row, 1, &HexPathHierarchy::buildIntraEdges, map);
+        forEachCluster(column, row, 2, &HexPathHierarchy::buildInterEdges, map);
+    }
+
+    /// 二点間の経路を探索する
+    /// @param map [in] 構築に使ったヘックスマップ
+    /// @param start [in] 開始地点
+    /// @param goal [in] 目標地点
+    /// @param path [out] 開始地点から目標地点までの位置 到達できなければ空
+    /// @retval 経路のコスト 到達できなければPathDistanceUnreachable
+    int FindPath(const HexMap<HexChip, Width, Height>& map,
+                 const HexMapPosition& start,
+                 const HexMapPosition& goal,
+                 std::vector<HexMapPosition>& path)
+    {
+        assert((map.GetWidth() == m_width) && (map.GetHeight() == m_height));
+        path.clear();
+        if (! (isPassable(map, start) && isPassable(map, goal))) { return PathDistanceUnreachable; }
+
+        const int abstract_cost = searchAbstract(map, start, goal);
+        if (abstract_cost < 0) { return PathDistanceUnreachable; }
+
+        // 抽象経路の隣り合う頂点の間を詳細化する
+        path.push_back(start);
+        for (std::size_t i(1); i < m_route.size(); ++i) {
+            appendSegment(map, m_route[i - 1], m_route[i], path);
+        }
+        return abstract_cost;
+    }
+
+    /// クラスタ数取得
+    int GetClusterCount() const { return static_cast<int>(m_clusters.size()); }
+    /// クラスタの一辺の長さ取得
+    int GetClusterSize() const { return m_cluster_size; }
+
+    /// 出入口の数取得
+    int GetNodeCount() const
+    {
+        int count(0);
+        for (std::size_t k(0); k < m_clusters.size(); ++k) { count += static_cast<int>(m_clusters[k].nodes.size()); }
+        return count;
+    }
+
+private:
+    /// コピー禁止
+    HexPathHierarchy(const HexPathHierarchy&);
+    HexPathHierarchy& operator=(const HexPathHierarchy&);
+
+    /// 抽象グラフの辺
+    struct Edge
+    {
+        int cluster; /// 行き先のクラスタ 同じクラスタならばクラスタ内の辺
+        int node;    /// 行き先の出入口
+        int cost;    /// コスト
+    };
+
+    /// 抽象グラフ探索の記録
+    /// 頂点に持たせ, 世代が今回の探索と違えば未到達とみなすので探索ごとに消さなくてよい
+    struct Record
+    {
+        Record()
+        :generation(0)
+        ,distance(0)
+        ,parent(0)
+        {}
+
+        unsigned int generation; /// 書き込んだ探索の世代
+        int distance;            /// 開始地点からのコスト
+        uint64_t parent;         /// 一つ手前の頂点
+    };
+
+    /// 出入口
+    struct Node
+    {
+        HexMapPosition pos;      /// 位置
+        std::vector<Edge> edges; /// 出ていく辺
+        Record record;           /// 探索の記録
+    };
+
+    /// クラスタ
+    struct Cluster
+    {
+        std::vector<Node> nodes; /// 出入口
+        /// 詳細化したクラスタ内の経路 (出入口, 出入口) ごと 行き先を含み出発点を含まない
+        std::map<std::pair<int, int>, std::vector<HexMapPosition> > paths;
+    };
+
+    /// 抽象経路の頂点
+    struct RouteNode
+    {
+        int cluster;        /// クラスタ
+        int node;           /// 出入口 開始地点と目標地点は負
+        HexMapPosition pos; /// 位置
+    };
+
+
+    /// 両端に出入口を置く区間の長さ
+    static const std::size_t s_long_run = 6;
+
+    /// 開始地点と目標地点を表す頂点
+    static uint64_t startKey() { return UINT64_C(0xfffffffffffffffe); }
+    static uint64_t goalKey()  { return UINT64_C(0xffffffffffffffff); }
+    /// 出入口を表す頂点
+    static uint64_t keyOf(int cluster, int node) { return (static_cast<uint64_t>(cluster) << 32) | static_cast<uint32_t>(node); }
+
+    /// クラスタ取得
+    int clusterOf(const HexMapPosition& pos) const { return pos.X() / m_cluster_size + m_columns * (pos.Y() / m_cluster_size); }
+    /// クラスタの左上取得
+    HexMapPosition originOf(int k) const { return HexMapPosition((k % m_columns) * m_cluster_size, (k / m_columns) * m_cluster_size); }
+    /// クラスタの右下の次の位置取得 マップの端で切り詰める
+    HexMapPosition limitOf(int k) const
+    {
+        const HexMapPosition origin = originOf(k);
+        return HexMapPosition(std::min(origin.X() + m_cluster_size, m_width), std::min(origin.Y() + m_cluster_size, m_height));
+    }
+    /// クラスタ内の添字取得
+    int localOf(int k, const HexMapPosition& pos) const
+    {
+        const HexMapPosition origin = originOf(k);
+        return (pos.X() - origin.X()) + m_cluster_size * (pos.Y() - origin.Y());
+    }
+
+    /// マップ内の侵入可能な位置であるか否か
+    bool isPassable(const HexMap<HexChip, Width, Height>& map, const HexMapPosition& pos) const
+    {
+        if ((pos.X() < 0) || (pos.Y() < 0) || (m_width <= pos.X()) || (m_height <= pos.Y())) { return false; }
+        return m_cost.IsPassable(map[pos].GetType());
+    }
+
+    /// マップにある地形の最小の移動コストを更新する
+    void updateMinCost(const HexChip& chip)
+    {
+        const int cost = m_cost(chip);
+        if (cost == HexMoveCost::Impassable) { return; }
+        if ((m_min_cost == 0) || (cost < m_min_cost)) { m_min_cost = cost; }
+    }
+
+    /// 出入口を探す
+    /// @retval 出入口 無ければ-1
+    int findNode(int k, const HexMapPosition& pos) const
+    {
+        const std::vector<Node>& nodes = m_clusters[k].nodes;
+        for (std::size_t i(0); i < nodes.size(); ++i) {
+            if (nodes[i].pos == pos) { return static_cast<int>(i); }
+        }
+        return -1;
+    }
+
+    /// 周りのクラスタに処理を行う
+    /// @param column [in] 中心のクラスタの列
+    /// @param row [in] 中心のクラスタの行
+    /// @param radius [in] 処理するクラスタの範囲
+    void forEachCluster(int column, int row, int radius,
+                        void (HexPathHierarchy::*func)(const HexMap<HexChip, Width, Height>&, int),
+                        const HexMap<HexChip, Width, Height>& map)
+    {
+        for (int j(std::max(row - radius, 0)); j <= std::min(row + radius, m_rows - 1); ++j) {
+            for (int i(std::max(column - radius, 0)); i <= std::min(column + radius, m_columns - 1); ++i) {
+                (this->*func)(map, i + m_columns * j);
+            }
+        }
+    }
+
+    /// 二つのクラスタの境界の出入口を求める
+    /// 境界をまたいで隣り合う通行可能な位置の組を境界に沿って並べ, 連続する区間ごとに中央の組を選ぶ
+    /// どちらのクラスタから求めても同じ組になる
+    /// @param map [in] ヘックスマップ
+    /// @param k [in] クラスタ
+    /// @param neighbor [in] 隣のクラスタ
+    /// @param transitions [out] (kの位置, neighborの位置) の組
+    void collectTransitions(const HexMap<HexChip, Width, Height>& map,
+                            int k,
+                            int neighbor,
+                            std::vector<std::pair<HexMapPosition, HexMapPosition> >& transitions) const
+    {
+        transitions.clear();
+        const int low  = std::min(k, neighbor);
+        const int high = std::max(k, neighbor);
+        const HexMapPosition origin = originOf(low);
+        const HexMapPosition limit  = limitOf(low);
+
+        // 境界に沿った順に並べる 低い側のクラスタの外周を行順に走査する
+        std::vector<std::pair<HexMapPosition, HexMapPosition> > pairs;
+        for (int y(origin.Y()); y < limit.Y(); ++y) {
+            const bool edge_row = (y == origin.Y()) || (y == limit.Y() - 1);
+            for (int x(origin.X()); x < limit.X(); x += (edge_row || (x == limit.X() - 1)) ? 1 : (limit.X() - 1 - x)) {
+                const HexMapPosition pos(x, y);
+                if (! isPassable(map, pos)) { continue; }
+                // 向こう側の位置も行順に並べる
+                const std::size_t first = pairs.size();
+                for (int n(0); n < HexMapPosition::NeighborCount; ++n) {
+                    const HexMapPosition candidate = pos.GetNeighbor(static_cast<HexMapPosition::Neighbor>(n));
+                    if (! isPassable(map, candidate)) { continue; }
+                    if (clusterOf(candidate) != high) { continue; }
+                    pairs.push_back(std::make_pair(pos, candidate));
+                    for (std::size_t i(pairs.size() - 1); (first < i) && (pairs[i].second < pairs[i - 1].second); --i) {
+                        std::swap(pairs[i], pairs[i - 1]);
+                    }
+                }
+            }
+        }
+
+        // 両側とも隣り合うか同じ位置ならば同じ区間
+        std::size_t run(0);
+        for (std::size_t i(1); i <= pairs.size(); ++i) {
+            if ((i < pairs.size())
+                && (HexDistance(pairs[i - 1].first, pairs[i].first) <= 1)
+                && (HexDistance(pairs[i - 1].second, pairs[i].second) <= 1)) { continue; }
+            // 長い区間は両端に置き, 区間に沿って遠回りしないようにする
+            if (i - run < s_long_run) {
+                pushTransition(pairs[(run + i - 1) / 2], low == k, transitions);
+            } else {
+                pushTransition(pairs[run], low == k, transitions);
+                pushTransition(pairs[i - 1], low == k, transitions);
+            }
+            run = i;
+        }
+    }
+
+    /// 出入口の組を加える
+    static void pushTransition(const std::pair<HexMapPosition, HexMapPosition>& transition,
+                               bool forward,
+                               std::vector<std::pair<HexMapPosition, HexMapPosition> >& transitions)
+    {
+        transitions.push_back(forward ? transition : std::make_pair(transition.second, transition.first));
+    }
+
+    /// クラスタの出入口を作り直す
+    /// 詳細化した経路も捨てる
+    void buildNodes(const HexMap<HexChip, Width, Height>& map, int k)
+    {
+        Cluster& cluster = m_clusters[k];
+        cluster.nodes.clear();
+        cluster.paths.clear();
+
+        const int column = k % m_columns;
+        const int row    = k / m_columns;
+        for (int j(std::max(row - 1, 0)); j <= std::min(row + 1, m_rows - 1); ++j) {
+            for (int i(std::max(column - 1, 0)); i <= std::min(column + 1, m_columns - 1); ++i) {
+                const int neighbor = i + m_columns * j;
+                if (neighbor == k) { continue; }
+                collectTransitions(map, k, neighbor, m_transitions);
+                for (std::size_t t(0); t < m_transitions.size(); ++t) {
+                    if (0 <= findNode(k, m_transitions[t].first)) { continue; }
+                    Node node;
+                    node.pos = m_transitions[t].first;
+                    cluster.nodes.push_back(node);
+                }
+            }
+        }
+    }
+
+    /// クラスタ内の出入口間の辺を作り直す
+    void buildIntraEdges(const HexMap<HexChip, Width, Height>& map, int k)
+    {
+        std::vector<Node>& nodes = m_clusters[k].nodes;
+        for (std::size_t a(0); a < nodes.size(); ++a) {
+            removeEdges(nodes[a].edges, k, true);
+            searchCluster(map, k, nodes[a].pos, NULL);
+            for (std::size_t b(0); b < nodes.size(); ++b) {
+                if (a == b) { continue; }
+                const int distance = m_local_distance[localOf(k, nodes[b].pos)];
+                if (distance < 0) { continue; }
+                const Edge edge = { k, static_cast<int>(b), distance };
+                nodes[a].edges.push_back(edge);
+            }
+        }
+    }
+
+    /// クラスタをまたぐ辺を作り直す
+    void buildInterEdges(const HexMap<HexChip, Width, Height>& map, int k)
+    {
+        std::vector<Node>& nodes = m_clusters[k].nodes;
+        for (std::size_t a(0); a < nodes.size(); ++a) { removeEdges(nodes[a].edges, k, false); }
+
+        const int column = k % m_columns;
+        const int row    = k / m_columns;
+        for (int j(std::max(row - 1, 0)); j <= std::min(row + 1, m_rows - 1); ++j) {
+            for (int i(std::max(column - 1, 0)); i <= std::min(column + 1, m_columns - 1); ++i) {
+                const int neighbor = i + m_columns * j;
+                if (neighbor == k) { continue; }
+                collectTransitions(map, k, neighbor, m_transitions);
+                for (std::size_t t(0); t < m_transitions.size(); ++t) {
+                    const int from = findNode(k, m_transitions[t].first);
+                    const int to   = findNode(neighbor, m_transitions[t].second);
+                    // 複数の位置を変えてから順に作り直すと, まだ作り直していないクラスタの出入口は古い
+                    // その組は, そのクラスタを含む位置を作り直すときに繋ぐ
+                    if ((from < 0) || (to < 0)) { continue; }
+                    const Edge edge = { neighbor, to, m_cost(map[m_transitions[t].second]) };
+                    nodes[from].edges.push_back(edge);
+                }
+            }
+        }
+    }
+
+    /// クラスタ内の辺かクラスタをまたぐ辺を取り除く
+    static void removeEdges(std::vector<Edge>& edges, int k, bool intra)
+    {
+        std::size_t kept(0);
+        for (std::size_t i(0); i < edges.size(); ++i) {
+            if ((edges[i].cluster == k) == intra) { continue; }
+            edges[kept++] = edges[i];
+        }
+        edges.resize(kept);
+    }
+
+    /// クラスタ内で探索する (ダイクストラ法)
+    /// 結果はm_local_distanceとm_local_parentに残る 到達していない位置は-1
+    /// @param map [in] ヘックスマップ
+    /// @param k [in] クラスタ
+    /// @param source [in] 開始地点
+    /// @param target [in] 目標地点 NULLならばクラスタ全体を探索する
+    void searchCluster(const HexMap<HexChip, Width, Height>& map, int k, const HexMapPosition& source, const HexMapPosition* target)
+    {
+        std::fill(m_local_distance.begin(), m_local_distance.end(), -1);
+        m_local_open.Clear();
+
+        const HexMapPosition origin = originOf(k);
+        const HexMapPosition limit  = limitOf(k);
+        m_local_distance[localOf(k, source)] = 0;
+        m_local_parent[localOf(k, source)]   = localOf(k, source);
+        m_local_open.Push(0, source);
+
+        while (! m_local_open.Empty()) {
+            const typename HexRadixHeap<HexMapPosition>::Entry entry = m_local_open.Pop();
+            const HexMapPosition pivot = entry.second;
+            const int current = m_local_distance[localOf(k, pivot)];
+            if (static_cast<int>(entry.first) != current) { continue; }
+            if ((target != NULL) && (pivot == *target)) { return; }
+
+            for (int i(0); i < HexMapPosition::NeighborCount; ++i) {
+                const HexMapPosition candidate = pivot.GetNeighbor(static_cast<HexMapPosition::Neighbor>(i));
+                if ((candidate.X() < origin.X()) || (candidate.Y() < origin.Y())) { continue; }
+                if ((limit.X() <= candidate.X()) || (limit.Y() <= candidate.Y())) { continue; }
+                if (! m_cost.IsPassable(map[candidate].GetType())) { continue; }
+
+                const int local = localOf(k, candidate);
+                const int next  = current + m_cost(map[candidate]);
+                if ((0 <= m_local_distance[local]) && (m_local_distance[local] <= next)) { continue; }
+                m_local_distance[local] = next;
+                m_local_parent[local]   = localOf(k, pivot);
+                m_local_open.Push(next, candidate);
+            }
+        }
+    }
+
+    /// 開始地点と目標地点を抽象グラフに繋いで探索する (A*)
+    /// 抽象経路はm_routeに残る
+    /// @retval コスト 到達できなければPathDistanceUnreachable
+    int searchAbstract(const HexMap<HexChip, Width, Height>& map, const HexMapPosition& start, const HexMapPosition& goal)
+    {
+        const int start_cluster = clusterOf(start);
+        const int goal_cluster  = clusterOf(goal);
+        const int min_cost      = m_min_cost;
+
+        // 目標地点のクラスタの出入口から目標地点までのコスト
+        // 目標地点からの探索を逆に辿ると d(n,goal) = d(goal,n) - cost[n] + cost[goal]
+        searchCluster(map, goal_cluster, goal, NULL);
+        const std::vector<Node>& goal_nodes = m_clusters[goal_cluster].nodes;
+        m_goal_cost.assign(goal_nodes.size(), -1);
+        for (std::size_t i(0); i < goal_nodes.size(); ++i) {
+            const int distance = m_local_distance[localOf(goal_cluster, goal_nodes[i].pos)];
+            if (distance < 0) { continue; }
+            m_goal_cost[i] = distance - m_cost(map[goal_nodes[i].pos]) + m_cost(map[goal]);
+        }
+
+        ++m_generation;
+        m_open.Clear();
+        m_goal_record.generation = 0;
+        m_start_record.generation = m_generation;
+        m_start_record.distance   = 0;
+        m_start_record.parent     = startKey();
+        m_open.Push(HexDistance(start, goal) * min_cost, startKey());
+
+        int result(PathDistanceUnreachable);
+        while (! m_open.Empty()) {
+            const typename HexRadixHeap<uint64_t>::Entry entry = m_open.Pop();
+            const uint64_t key = entry.second;
+            const int current = recordOf(key).distance;
+            if (key == goalKey()) {
+                if (static_cast<int>(entry.first) != current) { continue; }
+                result = current;
+                break;
+            }
+            const HexMapPosition pivot = positionOf(key, start, goal);
+            if (static_cast<int>(entry.first) != current + HexDistance(pivot, goal) * min_cost) { continue; }
+
+            if (key == startKey()) {
+                // 開始地点のクラスタの出入口へ, 同じクラスタならば目標地点へも直接
+                searchCluster(map, start_cluster, start, NULL);
+                const std::vector<Node>& nodes = m_clusters[start_cluster].nodes;
+                for (std::size_t i(0); i < nodes.size(); ++i) {
+                    const int distance = m_local_distance[localOf(start_cluster, nodes[i].pos)];
+                    if (0 <= distance) { relax(key, keyOf(start_cluster, static_cast<int>(i)), nodes[i].pos, distance, goal, min_cost); }
+                }
+                if (start_cluster == goal_cluster) {
+                    const int distance = m_local_distance[localOf(start_cluster, goal)];
+                    if (0 <= distance) { relax(key, goalKey(), goal, distance, goal, min_cost); }
+                }
+                continue;
+            }
+
+            const int cluster = static_cast<int>(key >> 32);
+            const int node    = static_cast<int>(key & 0xffffffffu);
+            const std::vector<Edge>& edges = m_clusters[cluster].nodes[node].edges;
+            for (std::size_t i(0); i < edges.size(); ++i) {
+                const Edge& edge = edges[i];
+                relax(key, keyOf(edge.cluster, edge.node), m_clusters[edge.cluster].nodes[edge.node].pos, current + edge.cost, goal, min_cost);
+            }
+            if ((cluster == goal_cluster) && (0 <= m_goal_cost[node])) {
+                relax(key, goalKey(), goal, current + m_goal_cost[node], goal, min_cost);
+            }
+        }
+        if (result < 0) { return PathDistanceUnreachable; }
+
+        // 目標地点から辿って抽象経路を作る
+        m_route.clear();
+        for (uint64_t key = goalKey(); ; key = recordOf(key).parent) {
+            RouteNode route;
+            route.cluster = (key == goalKey()) ? goal_cluster : ((key == startKey()) ? start_cluster : static_cast<int>(key >> 32));
+            route.node    = ((key == goalKey()) || (key == startKey())) ? -1 : static_cast<int>(key & 0xffffffffu);
+            route.pos     = positionOf(key, start, goal);
+            m_route.push_back(route);
+            if (key == startKey()) { break; }
+        }
+        std::reverse(m_route.begin(), m_route.end());
+        return result;
+    }
+
+    /// 頂点の位置取得
+    HexMapPosition positionOf(uint64_t key, const HexMapPosition& start, const HexMapPosition& goal) const
+    {
+        if (key == startKey()) { return start; }
+        if (key == goalKey())  { return goal; }
+        return m_clusters[static_cast<int>(key >> 32)].nodes[static_cast<int>(key & 0xffffffffu)].pos;
+    }
+
+    /// 頂点の探索の記録取得
+    Record& recordOf(uint64_t key)
+    {
+        if (key == startKey()) { return m_start_record; }
+        if (key == goalKey())  { return m_goal_record; }
+        return m_clusters[static_cast<int>(key >> 32)].nodes[static_cast<int>(key & 0xffffffffu)].record;
+    }
+
+    /// 頂点のコストを更新する
+    void relax(uint64_t from, uint64_t to, const HexMapPosition& pos, int distance, const HexMapPosition& goal, int min_cost)
+    {
+        Record& record = recordOf(to);
+        if ((record.generation == m_generation) && (record.distance <= distance)) { return; }
+        record.generation = m_generation;
+        record.distance   = distance;
+        record.parent     = from;
+        m_open.Push(distance + HexDistance(pos, goal) * min_cost, to);
+    }
+
+    /// 抽象経路の二つの頂点の間を詳細化して経路に加える
+    /// 別のクラスタならば一歩 同じクラスタならばクラスタ内の探索 出入口間の経路は覚えておく
+    void appendSegment(const HexMap<HexChip, Width, Height>& map, const RouteNode& from, const RouteNode& to, std::vector<HexMapPosition>& path)
+    {
+        if (from.cluster != to.cluster) {
+            path.push_back(to.pos);
+            return;
+        }
+
+        const bool cacheable = (0 <= from.node) && (0 <= to.node);
+        Cluster& cluster = m_clusters[from.cluster];
+        const std::pair<int, int> key(from.node, to.node);
+        if (cacheable) {
+            const typename std::map<std::pair<int, int>, std::vector<HexMapPosition> >::const_iterator it = cluster.paths.find(key);
+            if (it != cluster.paths.end()) {
+                path.insert(path.end(), it->second.begin(), it->second.end());
+                return;
+            }
+        }
+
+        searchCluster(map, from.cluster, from.pos, &to.pos);
+        const HexMapPosition origin = originOf(from.cluster);
+        const std::size_t first = path.size();
+        for (int local = localOf(from.cluster, to.pos); local != localOf(from.cluster, from.pos); local = m_local_parent[local]) {
+            path.push_back(HexMapPosition(origin.X() + local % m_cluster_size, origin.Y() + local / m_cluster_size));
+        }
+        std::reverse(path.begin() + first, path.end());
+        if (cacheable) { cluster.paths[key].assign(path.begin() + first, path.end()); }
+    }
+
+    HexMoveCost m_cost;   /// 移動コスト表
+    int m_cluster_size;   /// クラスタの一辺の長さ
+    int m_width;          /// マップ幅
+    int m_height;         /// マップ高さ
+    int m_columns;        /// クラスタの列数
+    int m_rows;           /// クラスタの行数
+    int m_min_cost;       /// マップにある地形の最小の移動コスト 抽象グラフ探索の推定値に使う
+    std::vector<Cluster> m_clusters; /// クラスタ
+
+    /// 作業領域 確保済みの領域を使い回す
+    std::vector<int> m_local_distance;                 /// クラスタ内の開始地点からのコスト
+    std::vector<int> m_local_parent;                   /// クラスタ内の一つ手前の位置
+    HexRadixHeap<HexMapPosition> m_local_open;         /// クラスタ内の探索の待ち行列
+    std::vector<std::pair<HexMapPosition, HexMapPosition> > m_transitions; /// 境界の出入口の組
+    std::vector<int> m_goal_cost;                      /// 目標地点のクラスタの出入口から目標地点までのコスト
+    Record m_start_record;                             /// 開始地点の探索の記録
+    Record m_goal_record;                              /// 目標地点の探索の記録
+    unsigned int m_generation;                         /// 探索の世代
+    HexRadixHeap<uint64_t> m_open;                     /// 抽象グラフ探索の待ち行列
+    std::vector<RouteNode> m_route;                    /// 抽象経路
+};
+
+template <int Width, int Height> const int HexPathHierarchy<Width, Height>::DefaultClusterSize;
+template <int Width, int Height> const std::size_t HexPathHierarchy<Width, Height>::s_long_run;
+
+#endif
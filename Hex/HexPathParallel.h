@@ -0,0 +1,301 @@
+//
+//  HexPathParallel.h
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#ifndef Hex_HexPathParallel_h
+#define Hex_HexPathParallel_h
+
+#include "HexMap.h"
+#include "HexPathExecutor.h"
+#include "HexSearchContext.h"
+
+#include <algorithm>
+#include <atomic>
+#include <stdint.h>
+#include <vector>
+
+/// @class 独立した経路探索の並列実行
+/// ワーカーごとに作業を一つだけ積み, 各作業が共有の計数器から次の探索の番号を取り出す
+/// 積む作業は組の数によらずワーカー数だけで, 探索の作業領域はワーカーごとに持ち, 実行のたびに使い回す
+/// @tparam Width マップ幅
+/// @tparam Height マップ高さ
+template <int Width, int Height>
+class HexPathQueryRunner
+{
+public:
+    /// コンストラクタ
+    HexPathQueryRunner()
+    :m_scratch()
+    ,m_contexts()
+    {}
+
+    /// デストラクタ
+    ~HexPathQueryRunner()
+    {
+        for (std::size_t i(0); i < m_contexts.size(); ++i) { delete m_contexts[i]; }
+    }
+
+    /// 開始地点ごとの経路マップと距離マップを生成する
+    /// @param executor [in] 実行スレッドプール
+    /// @param map [in] ヘックスマップ
+    /// @param starts [in] 開始地点の配列
+    /// @param count [in] 開始地点の数
+    /// @param path_maps [out] 開始地点ごとの経路マップ count個
+    /// @param distance_maps [out] 開始地点ごとの距離マップ count個
+    void Generate(HexPathExecutor& executor,
+                  const HexMap<HexChip, Width, Height>& map,
+                  const HexMapPosition* starts,
+                  int count,
+                  HexMap<HexMapPosition, Width, Height>* path_maps,
+                  HexMap<int, Width, Height>* distance_maps)
+    {
+        if (static_cast<int>(m_scratch.size()) < executor.GetWorkerCount()) {
+            m_scratch.resize(executor.GetWorkerCount());
+        }
+        std::vector<HexPathScratch>& scratch = m_scratch;
+        runPerWorker(executor, count, [&](int i, int worker) {
+            GeneratePathMap(map, starts + i, starts + i + 1, path_maps[i], distance_maps[i], scratch[worker]);
+        });
+    }
+
+    /// 開始地点と目標地点の組ごとに経路を探索する (A*)
+    /// ワーカーごとの探索の作業領域を使い回すので, 二回目以降の実行では探索でメモリを確保しない
+    /// 作業キューへの受け渡しはワーカーごとに一つだけで, 組の数には比例しない
+    /// ただし作業キュー自身が領域を足すことはあるので, 実行全体で確保しないとは限らない
+    /// @param executor [in] 実行スレッドプール
+    /// @param map [in] ヘックスマップ
+    /// @param cost [in] 移動コスト表
+    /// @param starts [in] 開始地点の配列
+    /// @param goals [in] 目標地点の配列
+    /// @param count [in] 組の数
+    /// @param distances [out] 組ごとの目標地点までのコスト count個 到達できなければPathDistanceUnreachable
+    void FindPaths(HexPathExecutor& executor,
+                   const HexMap<HexChip, Width, Height>& map,
+                   const HexMoveCost& cost,
+                   const HexMapPosition* starts,
+                   const HexMapPosition* goals,
+                   int count,
+                   int* distances)
+    {
+        while (static_cast<int>(m_contexts.size()) < executor.GetWorkerCount()) {
+            m_contexts.push_back(new HexSearchContext());
+        }
+        std::vector<HexSearchContext*>& contexts = m_contexts;
+        runPerWorker(executor, count, [&](int i, int worker) {
+            distances[i] = FindPath(map, cost, starts[i], goals[i], *contexts[worker]);
+        });
+    }
+
+private:
+    // コピー禁止
+    HexPathQueryRunner(const HexPathQueryRunner&);
+    HexPathQueryRunner& operator=(const HexPathQueryRunner&);
+
+    /// ワーカーごとに作業を一つ積み, 番号を一つずつ取り出して処理させ, 終わるまで待つ
+    /// 積む作業は共有の状態への参照一つだけを持つので, 関数オブジェクトの中に収まる
+    /// 同じワーカーが二つの作業を続けて実行しても, 番号の取り出しは共有なので重複しない
+    /// @tparam Function void(int index, int worker)
+    /// @param executor [in] 実行スレッドプール
+    /// @param count [in] 番号の数
+    /// @param function [in] 番号ごとの処理
+    template <class Function>
+    static void runPerWorker(HexPathExecutor& executor, int count, const Function& function)
+    {
+        /// 作業の間で共有する状態
+        struct Shared
+        {
+            const Function*  function; /// 番号ごとの処理
+            int              count;    /// 番号の数
+            std::atomic<int> next;     /// 次に取り出す番号
+        };
+        Shared shared;
+        shared.function = &function;
+        shared.count    = count;
+        shared.next.store(0);
+
+        const int task_count = std::min(count, executor.GetWorkerCount());
+        for (int t(0); t < task_count; ++t) {
+            executor.Submit([&shared](int worker) {
+                for (int i = shared.next++; i < shared.count; i = shared.next++) {
+                    (*shared.function)(i, worker);
+                }
+            });
+        }
+        executor.Wait();
+    }
+
+    /// ワーカーごとの作業領域
+    std::vector<HexPathScratch> m_scratch;
+    /// ワーカーごとの探索の作業領域
+    std::vector<HexSearchContext*> m_contexts;
+};
+
+/// @class 並列の幅優先探索の作業領域
+/// 位置ごとの世代と前線を持ち, 探索のたびに世代を進めて前の探索の訪問済みの印を無効にする
+/// 同じ大きさのマップで探索を続ければ, 訪問済みの印を確保し直すことも消すこともない
+class HexParallelPathScratch
+{
+public:
+    /// コンストラクタ
+    HexParallelPathScratch()
+    :frontier()
+    ,local_next()
+    ,m_stamps(NULL)
+    ,m_size(0)
+    ,m_generation(0)
+    {}
+
+    /// デストラクタ
+    ~HexParallelPathScratch() { delete[] m_stamps; }
+
+    /// 探索を始める
+    /// 大きさが変われば位置ごとの世代を確保し直し, 世代を進める
+    /// @param size [in] 位置の数
+    /// @param worker_count [in] ワーカー数
+    void Begin(int size, int worker_count)
+    {
+        if (m_size != size) {
+            delete[] m_stamps;
+            m_stamps = new std::atomic<uint32_t>[size];
+            m_size   = size;
+            resetStamps();
+        }
+        // 世代が一周したら, 前の探索の印と区別できるよう全て消す
+        if (++m_generation == 0) {
+            resetStamps();
+            m_generation = 1;
+        }
+        if (static_cast<int>(local_next.size()) < worker_count) { local_next.resize(worker_count); }
+        frontier.clear();
+        for (std::size_t w(0); w < local_next.size(); ++w) { local_next[w].clear(); }
+    }
+
+    /// 訪問済みの印を立てる
+    /// 複数のワーカーが同時に立てても, 一つのワーカーだけが成功する
+    /// @param index [in] 位置の添字
+    /// @retval この探索で初めて立てたならばtrue
+    bool Visit(int index)
+    {
+        uint32_t stamp = m_stamps[index].load(std::memory_order_relaxed);
+        while (stamp != m_generation) {
+            if (m_stamps[index].compare_exchange_weak(stamp, m_generation, std::memory_order_relaxed)) { return true; }
+        }
+        return false;
+    }
+
+    std::vector<HexMapPosition> frontier;                  /// 前線
+    std::vector<std::vector<HexMapPosition> > local_next;  /// ワーカーごとの次の前線
+
+private:
+    /// 位置ごとの世代を全て消す
+    void resetStamps()
+    {
+        for (int i(0); i < m_size; ++i) { m_stamps[i].store(0, std::memory_order_relaxed); }
+    }
+
+    // コピー禁止
+    HexParallelPathScratch(const HexParallelPathScratch&);
+    HexParallelPathScratch& operator=(const HexParallelPathScratch&);
+
+    std::atomic<uint32_t>* m_stamps; /// 位置ごとの訪問した世代
+    int m_size;                      /// 位置の数
+    uint32_t m_generation;           /// 世代
+};
+
+/// 経路マップと距離マップを並列に生成する
+/// 前線を一段ずつワーカーで分割して広げる幅優先探索
+/// 訪問済みの印は作業領域の世代を不可分操作で書き換え, 最初に書き換えたワーカーだけが距離と経路を書き込む
+/// 距離マップはGeneratePathMapと一致するが, 同じ距離の経路が複数あるときの経路マップは異なる場合がある
+/// @param executor [in] 実行スレッドプール
+/// @param map [in] ヘックスマップ
+/// @param start [in] 開始地点
+/// @param path_map [out] 経路マップ 到達できない位置は自身を指す
+/// @param distance_map [out] 距離マップ 到達できない位置はPathDistanceUnreachable 侵入不可の位置はPathDistanceNoEntry
+/// @param scratch [in,out] 作業領域 確保済みの領域を使い回す
+/// @retval 到達できた位置の数
+template <int Width, int Height>
+int GeneratePathMapParallel(HexPathExecutor& executor,
+                            const HexMap<HexChip, Width, Height>& map,
+                            const HexMapPosition& start,
+                            HexMap<HexMapPosition, Width, Height>& path_map,
+                            HexMap<int, Width, Height>& distance_map,
+                            HexParallelPathScratch& scratch)
+{
+    assert((path_map.GetWidth() == map.GetWidth()) && (path_map.GetHeight() == map.GetHeight()));
+    assert((distance_map.GetWidth() == map.GetWidth()) && (distance_map.GetHeight() == map.GetHeight()));
+
+    /// 一つの作業で受け持つ前線の位置の数
+    const int grain = 1024;
+    const int width = map.GetWidth();
+    scratch.Begin(map.Size(), executor.GetWorkerCount());
+
+    executor.ParallelFor(map.GetHeight(), 16, [&](int begin, int end, int) {
+        for (int j(begin); j < end; ++j) {
+            for (int i(0); i < width; ++i) {
+                const HexMapPosition pos(i, j);
+                path_map[pos]     = pos;
+                distance_map[pos] = (map[pos] == HexChip::NoEntry) ? PathDistanceNoEntry : PathDistanceUnreachable;
+            }
+        }
+    });
+    if (! IsEntriable(map, start)) { return 0; }
+
+    /// 開始地点設定
+    std::vector<HexMapPosition>& frontier = scratch.frontier;
+    std::vector<std::vector<HexMapPosition> >& local_next = scratch.local_next;
+    frontier.push_back(start);
+    scratch.Visit(start.X() + width * start.Y());
+    distance_map[start] = 0;
+    int reached(1);
+
+    for (int distance(1); ! frontier.empty(); ++distance) {
+        executor.ParallelFor(static_cast<int>(frontier.size()), grain, [&](int begin, int end, int worker) {
+            std::vector<HexMapPosition>& next = local_next[worker];
+            for (int f(begin); f < end; ++f) {
+                const HexMapPosition pivot = frontier[f];
+                for (int n(0); n < HexMapPosition::NeighborCount; ++n) {
+                    const HexMapPosition candidate = pivot.GetNeighbor(static_cast<HexMapPosition::Neighbor>(n));
+                    if (! IsEntriable(map, candidate)) { continue; }
+                    if (! scratch.Visit(candidate.X() + width * candidate.Y())) { continue; }
+
+                    distance_map[candidate] = distance;
+                    path_map[candidate]     = pivot;
+                    next.push_back(candidate);
+                }
+            }
+        });
+
+        frontier.clear();
+        for (std::size_t w(0); w < local_next.size(); ++w) {
+            frontier.insert(frontier.end(), local_next[w].begin(), local_next[w].end());
+            local_next[w].clear();
+        }
+        reached += static_cast<int>(frontier.size());
+    }
+    return reached;
+}
+
+/// 経路マップと距離マップを並列に生成する
+/// 作業領域を毎回確保するので, 繰り返し探索するときは作業領域を受け取る版を使う
+/// @param executor [in] 実行スレッドプール
+/// @param map [in] ヘックスマップ
+/// @param start [in] 開始地点
+/// @param path_map [out] 経路マップ 到達できない位置は自身を指す
+/// @param distance_map [out] 距離マップ 到達できない位置はPathDistanceUnreachable 侵入不可の位置はPathDistanceNoEntry
+/// @retval 到達できた位置の数
+template <int Width, int Height>
+int GeneratePathMapParallel(HexPathExecutor& executor,
+                            const HexMap<HexChip, Width, Height>& map,
+                            const HexMapPosition& start,
+                            HexMap<HexMapPosition, Width, Height>& path_map,
+                            HexMap<int, Width, Height>& distance_map)
+{
+    HexParallelPathScratch scratch;
+    return GeneratePathMapParallel(executor, map, start, path_map, distance_map, scratch);
+}
+
+#endif
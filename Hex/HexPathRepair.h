@@ -0,0 +1,191 @@
+//
+//  HexPathRepair.h
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#ifndef Hex_HexPathRepair_h
+#define Hex_HexPathRepair_h
+
+#include "HexPathFinder.h"
+
+#include <vector>
+
+/// @class 経路マップの部分修復
+/// 地形が変わった位置の一覧を受け取り, 影響する範囲だけ経路マップと距離マップを作り直す
+/// 変更位置を経由していた位置 (経路マップ上の子孫) を未確定に戻し,
+/// 確定している隣から距離を入れ直してダイクストラ法で広げる (LPA*と同じく影響範囲だけを再計算する)
+/// 距離が0の位置を開始地点とみなすので, 複数の開始地点から生成したマップも修復できる
+/// @tparam Width マップ幅
+/// @tparam Height マップ高さ
+template <int Width, int Height>
+class HexPathRepairer
+{
+public:
+    /// コンストラクタ
+    HexPathRepairer()
+    :m_open()
+    ,m_invalid()
+    ,m_seeds()
+    {}
+
+    /// 移動コストを考慮した経路マップを修復する
+    /// @tparam InputIterator HexMapPositionを指す入力イテレータ
+    /// @param map [in] 地形を変更した後のヘックスマップ
+    /// @param cost [in] マップ生成時と同じ移動コスト表
+    /// @param first [in] 地形を変更した位置の先頭
+    /// @param last [in] 地形を変更した位置の終端
+    /// @param path_map [in,out] GenerateCostMapで生成した経路マップ
+    /// @param distance_map [in,out] GenerateCostMapで生成したコストマップ
+    /// @retval 距離を計算し直した位置の数
+    template <class InputIterator>
+    int Repair(const HexMap<HexChip, Width, Height>& map,
+               const HexMoveCost& cost,
+               InputIterator first,
+               InputIterator last,
+               HexMap<HexMapPosition, Width, Height>& path_map,
+               HexMap<int, Width, Height>& distance_map)
+    {
+        m_open.Clear();
+        m_invalid.clear();
+        m_seeds.clear();
+
+        for (; first != last; ++first) {
+            const HexMapPosition pos = *first;
+            const int distance = distance_map[pos];
+
+            if (! cost.IsPassable(map[pos].GetType())) {
+                // 塞がれた位置を経由していた位置はすべて未確定に戻す
+                if (0 <= distance) { invalidate(pos, path_map, distance_map); }
+                distance_map[pos] = PathDistanceNoEntry;
+                path_map[pos]     = pos;
+                continue;
+            }
+
+            if (distance == PathDistanceNoEntry) {
+                // 開いた位置は隣から距離を入れる
+                distance_map[pos] = PathDistanceUnreachable;
+                path_map[pos]     = pos;
+                m_seeds.push_back(pos);
+            }
+            else if (distance == PathDistanceUnreachable) {
+                m_seeds.push_back(pos);
+            }
+            else if (0 < distance) {
+                // コストが変わった位置とその子孫は距離を入れ直す
+                invalidate(pos, path_map, distance_map);
+            }
+        }
+
+        // 未確定の位置に, 確定している隣からの距離を入れる
+        m_seeds.insert(m_seeds.end(), m_invalid.begin(), m_invalid.end());
+        for (std::size_t s(0); s < m_seeds.size(); ++s) {
+            const HexMapPosition pos = m_seeds[s];
+            if (distance_map[pos] != PathDistanceUnreachable) { continue; }
+
+            const int step = cost(map[pos]);
+            for (int i(0); i < HexMapPosition::NeighborCount; ++i) {
+                const HexMapPosition neighbor = pos.GetNeighbor(static_cast<HexMapPosition::Neighbor>(i));
+                if (! IsEntriable(map, cost, neighbor)) { continue; }
+
+                const int from = distance_map[neighbor];
+                if (from < 0) { continue; }
+                const int current = distance_map[pos];
+                if ((current == PathDistanceUnreachable) || (from + step < current)) {
+                    distance_map[pos] = from + step;
+                    path_map[pos]     = neighbor;
+                }
+            }
+            if (distance_map[pos] != PathDistanceUnreachable) {
+                m_open.Push(distance_map[pos], pos);
+            }
+        }
+
+        // 入れ直した距離から広げる 改善される位置だけを書き換える
+        int updated(0);
+        while (! m_open.Empty()) {
+            const typename HexRadixHeap<HexMapPosition>::Entry entry = m_open.Pop();
+            const HexMapPosition pivot = entry.second;
+            const int current = distance_map[pivot];
+            if (static_cast<int>(entry.first) != current) { continue; }
+            ++updated;
+
+            for (int i(0); i < HexMapPosition::NeighborCount; ++i) {
+                const HexMapPosition candidate = pivot.GetNeighbor(static_cast<HexMapPosition::Neighbor>(i));
+                if (! IsEntriable(map, cost, candidate)) { continue; }
+
+                const int next = current + cost(map[candidate]);
+                const int known = distance_map[candidate];
+                if ((known != PathDistanceUnreachable) && (known <= next)) { continue; }
+
+                distance_map[candidate] = next;
+                path_map[candidate]     = pivot;
+                m_open.Push(next, candidate);
+            }
+        }
+        return updated;
+    }
+
+    /// 経路マップを修復する
+    /// GeneratePathMapで生成した歩数の経路マップ用
+    /// @tparam InputIterator HexMapPositionを指す入力イテレータ
+    /// @param map [in] 地形を変更した後のヘックスマップ
+    /// @param first [in] 地形を変更した位置の先頭
+    /// @param last [in] 地形を変更した位置の終端
+    /// @param path_map [in,out] GeneratePathMapで生成した経路マップ
+    /// @param distance_map [in,out] GeneratePathMapで生成した距離マップ
+    /// @retval 距離を計算し直した位置の数
+    template <class InputIterator>
+    int Repair(const HexMap<HexChip, Width, Height>& map,
+               InputIterator first,
+               InputIterator last,
+               HexMap<HexMapPosition, Width, Height>& path_map,
+               HexMap<int, Width, Height>& distance_map)
+    {
+        return Repair(map, HexMoveCost::Uniform(), first, last, path_map, distance_map);
+    }
+
+private:
+    /// 位置とその子孫を未確定に戻す
+    /// 子は経路マップでその位置を指している隣
+    /// @param root [in] 位置
+    /// @param path_map [in,out] 経路マップ
+    /// @param distance_map [in,out] 距離マップ
+    void invalidate(const HexMapPosition& root,
+                    HexMap<HexMapPosition, Width, Height>& path_map,
+                    HexMap<int, Width, Height>& distance_map)
+    {
+        std::size_t head = m_invalid.size();
+        m_invalid.push_back(root);
+        distance_map[root] = PathDistanceUnreachable;
+        path_map[root]     = root;
+
+        for (; head < m_invalid.size(); ++head) {
+            const HexMapPosition parent = m_invalid[head];
+            for (int i(0); i < HexMapPosition::NeighborCount; ++i) {
+                const HexMapPosition child = parent.GetNeighbor(static_cast<HexMapPosition::Neighbor>(i));
+                if (! isInside(distance_map, child)) { continue; }
+                if (distance_map[child] <= 0) { continue; }
+                if (path_map[child] != parent) { continue; }
+
+                distance_map[child] = PathDistanceUnreachable;
+                path_map[child]     = child;
+                m_invalid.push_back(child);
+            }
+        }
+    }
+
+    /// マップの範囲内であるか否か
+    static bool isInside(const HexMap<int, Width, Height>& map, const HexMapPosition& pos)
+    {
+        return (0 <= pos.X()) && (0 <= pos.Y()) && (pos.X() < map.GetWidth()) && (pos.Y() < map.GetHeight());
+    }
+
+    HexRadixHeap<HexMapPosition> m_open;    /// 広げる位置の待ち行列
+    std::vector<HexMapPosition>  m_invalid; /// 未確定に戻した位置
+    std::vector<HexMapPosition>  m_seeds;   /// 隣から距離を入れる位置
+};
+
+#endif
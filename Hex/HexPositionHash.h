@@ -0,0 +1,279 @@
+//
+//  HexPositionHash.h
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#ifndef Hex_HexPositionHash_h
+#define Hex_HexPositionHash_h
+
+#include "HexMapPosition.h"
+
+#include <cassert>
+#include <climits>
+#include <cstddef>
+#include <vector>
+
+/// @class 位置をキーとする開番地法のハッシュ表
+/// 要素を一つの配列に並べ, 衝突したら次の要素を調べる (線形探査)
+/// 削除は後続の要素を前に詰めるので, 墓標を残さず探査が伸びない
+/// 空きは使わない位置 (INT_MIN, INT_MIN) で表す
+/// @tparam Slot 要素 キーの位置keyを持つ
+template <class Slot>
+class HexPositionHashTable
+{
+public:
+    /// コンストラクタ
+    HexPositionHashTable()
+    :m_slots()
+    ,m_mask(0)
+    ,m_size(0)
+    {}
+
+    /// 全要素を削除する
+    /// 確保した領域は残す
+    void Clear()
+    {
+        if (m_size == 0) { return; }
+        for (std::size_t i(0); i < m_slots.size(); ++i) { m_slots[i].key = emptyKey(); }
+        m_size = 0;
+    }
+
+    /// 要素数分の領域を確保する
+    /// @param count [in] 要素数
+    void Reserve(int count)
+    {
+        std::size_t capacity(16);
+        while (capacity * s_load_num < static_cast<std::size_t>(count) * s_load_den) { capacity *= 2; }
+        if (m_slots.size() < capacity) { rehash(capacity); }
+    }
+
+    /// 位置を含むか否か
+    /// @param pos [in] 位置
+    bool Contains(const HexMapPosition& pos) const { return 0 <= findIndex(pos); }
+
+    /// 要素数取得
+    int Size() const { return m_size; }
+    /// 空であるか否か
+    bool Empty() const { return m_size == 0; }
+    /// 要素を置ける数取得
+    int GetCapacity() const { return static_cast<int>(m_slots.size()); }
+
+protected:
+    /// 空きを表すキー
+    static HexMapPosition emptyKey() { return HexMapPosition(INT_MIN, INT_MIN); }
+
+    /// 位置の要素の添字を探す
+    /// @retval 添字 無ければ-1
+    int findIndex(const HexMapPosition& pos) const
+    {
+        if (m_size == 0) { return -1; }
+        for (std::size_t i = home(pos); ; i = (i + 1) & m_mask) {
+            if (m_slots[i].key == pos) { return static_cast<int>(i); }
+            if (m_slots[i].key == emptyKey()) { return -1; }
+        }
+    }
+
+    /// 位置の要素の添字を探し, 無ければ空きに置く
+    /// @param pos [in] 位置
+    /// @param inserted [out] 置いたならばtrue
+    /// @retval 添字
+    int insertIndex(const HexMapPosition& pos, bool& inserted)
+    {
+        assert(pos != emptyKey());
+        if (m_slots.size() * s_load_num < static_cast<std::size_t>(m_size + 1) * s_load_den) {
+            rehash(m_slots.empty() ? 16 : m_slots.size() * 2);
+        }
+        for (std::size_t i = home(pos); ; i = (i + 1) & m_mask) {
+            if (m_slots[i].key == pos) {
+                inserted = false;
+                return static_cast<int>(i);
+            }
+            if (m_slots[i].key == emptyKey()) {
+                m_slots[i].key = pos;
+                ++m_size;
+                inserted = true;
+                return static_cast<int>(i);
+            }
+        }
+    }
+
+    /// 添字の要素を削除する
+    /// 後続の要素のうち, 本来の位置から空きを跨がずに届くものを前に詰める
+    void eraseIndex(int index)
+    {
+        std::size_t hole = index;
+        for (std::size_t i = (hole + 1) & m_mask; m_slots[i].key != emptyKey(); i = (i + 1) & m_mask) {
+            // 本来の位置からの距離が空きまでの距離以上ならば空きに移せる
+            const std::size_t distance = (i - home(m_slots[i].key)) & m_mask;
+            if (((i - hole) & m_mask) <= distance) {
+                m_slots[hole] = m_slots[i];
+                hole = i;
+            }
+        }
+        m_slots[hole].key = emptyKey();
+        --m_size;
+    }
+
+    /// 本来の添字
+    std::size_t home(const HexMapPosition& pos) const { return HexMapPositionHash()(pos) & m_mask; }
+
+    std::vector<Slot> m_slots; /// 要素 大きさは2の冪
+
+private:
+    /// 大きさを変えて置き直す
+    void rehash(std::size_t capacity)
+    {
+        std::vector<Slot> slots(capacity);
+        for (std::size_t i(0); i < capacity; ++i) { slots[i].key = emptyKey(); }
+        slots.swap(m_slots);
+        m_mask = capacity - 1;
+        for (std::size_t i(0); i < slots.size(); ++i) {
+            if (slots[i].key == emptyKey()) { continue; }
+            std::size_t j = home(slots[i].key);
+            while (m_slots[j].key != emptyKey()) { j = (j + 1) & m_mask; }
+            m_slots[j] = slots[i];
+        }
+    }
+
+    /// 負荷率の上限 s_load_num / s_load_den
+    static const std::size_t s_load_num = 3;
+    static const std::size_t s_load_den = 4;
+
+    std::size_t m_mask; /// 添字の剰余を取るマスク
+    int m_size;         /// 要素数
+};
+
+
+/// 位置の集合の要素
+struct HexPositionSetSlot
+{
+    HexMapPosition key; /// 位置
+};
+
+/// @class 位置の集合
+/// 疎な探索の閉集合など, 大きなマップのごく一部の位置だけを覚えるときに使う
+class HexPositionFlatSet : public HexPositionHashTable<HexPositionSetSlot>
+{
+public:
+    /// 位置を加える
+    /// @param pos [in] 位置
+    /// @retval 加えたならばtrue 既に含んでいればfalse
+    bool Insert(const HexMapPosition& pos)
+    {
+        bool inserted(false);
+        insertIndex(pos, inserted);
+        return inserted;
+    }
+
+    /// 位置を取り除く
+    /// @param pos [in] 位置
+    /// @retval 取り除いたならばtrue 含んでいなければfalse
+    bool Erase(const HexMapPosition& pos)
+    {
+        const int index = findIndex(pos);
+        if (index < 0) { return false; }
+        eraseIndex(index);
+        return true;
+    }
+
+    /// 全要素を辿る
+    /// 順序は決まらない
+    /// @tparam Function 位置を受け取る関数
+    /// @param f [in] 関数
+    template <class Function>
+    void ForEach(Function f) const
+    {
+        for (std::size_t i(0); i < m_slots.size(); ++i) {
+            if (m_slots[i].key != emptyKey()) { f(m_slots[i].key); }
+        }
+    }
+};
+
+
+/// 位置の連想配列の要素
+template <class Value>
+struct HexPositionMapSlot
+{
+    HexMapPosition key; /// 位置
+    Value value;        /// 値
+};
+
+/// @class 位置の連想配列
+/// 疎な探索の距離や経路など, 大きなマップのごく一部の位置の値だけを覚えるときに使う
+/// 要素の追加と削除で表を置き直すことがあるので, 値への参照やポインタは次の追加, 削除までしか使えない
+/// @tparam Value 値 既定構築と代入ができること
+template <class Value>
+class HexPositionFlatMap : public HexPositionHashTable<HexPositionMapSlot<Value> >
+{
+    typedef HexPositionHashTable<HexPositionMapSlot<Value> > Base;
+
+public:
+    /// 値を取得し, 無ければ既定値で加える
+    /// @param pos [in] 位置
+    Value& operator[](const HexMapPosition& pos)
+    {
+        bool inserted(false);
+        const int index = this->insertIndex(pos, inserted);
+        if (inserted) { this->m_slots[index].value = Value(); }
+        return this->m_slots[index].value;
+    }
+
+    /// 値を加える
+    /// 既に含んでいれば値を変えない
+    /// @param pos [in] 位置
+    /// @param value [in] 値
+    /// @retval 加えたならばtrue 既に含んでいればfalse
+    bool Insert(const HexMapPosition& pos, const Value& value)
+    {
+        bool inserted(false);
+        const int index = this->insertIndex(pos, inserted);
+        if (inserted) { this->m_slots[index].value = value; }
+        return inserted;
+    }
+
+    /// 値を探す
+    /// @param pos [in] 位置
+    /// @retval 値へのポインタ 無ければNULL
+    Value* Find(const HexMapPosition& pos)
+    {
+        const int index = this->findIndex(pos);
+        return (index < 0) ? NULL : &this->m_slots[index].value;
+    }
+
+    /// 値を探す
+    /// @param pos [in] 位置
+    /// @retval 値へのポインタ 無ければNULL
+    const Value* Find(const HexMapPosition& pos) const
+    {
+        const int index = this->findIndex(pos);
+        return (index < 0) ? NULL : &this->m_slots[index].value;
+    }
+
+    /// 要素を取り除く
+    /// @param pos [in] 位置
+    /// @retval 取り除いたならばtrue 含んでいなければfalse
+    bool Erase(const HexMapPosition& pos)
+    {
+        const int index = this->findIndex(pos);
+        if (index < 0) { return false; }
+        this->eraseIndex(index);
+        return true;
+    }
+
+    /// 全要素を辿る
+    /// 順序は決まらない
+    /// @tparam Function 位置と値を受け取る関数
+    /// @param f [in] 関数
+    template <class Function>
+    void ForEach(Function f) const
+    {
+        for (std::size_t i(0); i < this->m_slots.size(); ++i) {
+            if (this->m_slots[i].key != Base::emptyKey()) { f(this->m_slots[i].key, this->m_slots[i].value); }
+        }
+    }
+};
+
+#endif
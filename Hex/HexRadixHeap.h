@@ -0,0 +1,110 @@
+//
+//  HexRadixHeap.h
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#ifndef Hex_HexRadixHeap_h
+#define Hex_HexRadixHeap_h
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/// @class 基数ヒープ
+/// 取り出すキーが単調非減少となる整数キーの優先度付きキュー
+/// ダイクストラ法や無矛盾な推定値を用いたA*の待ち行列に使う
+/// @tparam T キーに対応付ける値
+template <class T>
+class HexRadixHeap
+{
+public:
+    /// 要素 キーと値の組
+    typedef std::pair<unsigned int, T> Entry;
+
+    /// コンストラクタ
+    HexRadixHeap()
+    :m_buckets(BucketCount)
+    ,m_last(0)
+    ,m_size(0)
+    {}
+
+    /// 要素追加
+    /// @param key [in] キー 最後に取り出したキー以上であること
+    /// @param value [in] 値
+    void Push(unsigned int key, const T& value)
+    {
+        assert(m_last <= key);
+        m_buckets[bucketOf(key)].push_back(Entry(key, value));
+        ++m_size;
+    }
+
+    /// 最小キーの要素を取り出す
+    /// @retval 取り出した要素
+    Entry Pop()
+    {
+        assert(0 < m_size);
+        if (m_buckets[0].empty()) {
+            int i(1);
+            while (m_buckets[i].empty()) { ++i; }
+
+            // 最小キーを基準にし直すと, このバケットの要素はすべて下位のバケットへ移る
+            std::vector<Entry>& bucket = m_buckets[i];
+            unsigned int min_key = bucket[0].first;
+            for (std::size_t k(1); k < bucket.size(); ++k) {
+                if (bucket[k].first < min_key) { min_key = bucket[k].first; }
+            }
+            m_last = min_key;
+            for (std::size_t k(0); k < bucket.size(); ++k) {
+                m_buckets[bucketOf(bucket[k].first)].push_back(bucket[k]);
+            }
+            bucket.clear();
+        }
+        const Entry entry = m_buckets[0].back();
+        m_buckets[0].pop_back();
+        --m_size;
+        return entry;
+    }
+
+    /// 空であるか否か
+    bool Empty() const { return m_size == 0; }
+
+    /// 要素数取得
+    std::size_t Size() const { return m_size; }
+
+    /// 全要素削除
+    /// 確保済みの領域は再利用のために残す
+    void Clear()
+    {
+        for (int i(0); i < BucketCount; ++i) { m_buckets[i].clear(); }
+        m_last = 0;
+        m_size = 0;
+    }
+
+private:
+    /// バケット数 キーのビット数+1
+    enum { BucketCount = 33 };
+
+    /// キーを格納するバケットを取得
+    /// 最後に取り出したキーと異なる最上位ビットの位置で決まる
+    int bucketOf(unsigned int key) const
+    {
+        if (key == m_last) { return 0; }
+#if defined(__GNUC__)
+        return 32 - __builtin_clz(key ^ m_last);
+#else
+        int bit(0);
+        for (unsigned int diff = key ^ m_last; diff != 0; diff >>= 1) { ++bit; }
+        return bit;
+#endif
+    }
+
+    std::vector<std::vector<Entry> > m_buckets; /// バケット
+    unsigned int m_last;                        /// 最後に取り出したキー
+    std::size_t m_size;                         /// 要素数
+};
+
+#endif
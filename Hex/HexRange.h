@@ -0,0 +1,482 @@
+//
+//  HexRange.h
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#ifndef Hex_HexRange_h
+#define Hex_HexRange_h
+
+#include "HexAxialPosition.h"
+#include "HexMapPosition.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
+/// @class 環の位置の走査
+/// 中心からLeftの方向に半径だけ進んだ位置から, HexMapPosition::Neighbor順に各辺を半径歩ずつ辿る
+/// 半径0ならば中心だけ
+class HexRingCursor
+{
+public:
+    /// コンストラクタ
+    /// 走査を終えた状態を作る
+    HexRingCursor()
+    :m_pos()
+    ,m_radius(0)
+    ,m_side(HexMapPosition::NeighborCount)
+    ,m_step(0)
+    {}
+
+    /// コンストラクタ
+    /// @param center [in] 中心
+    /// @param radius [in] 半径 負ならば空
+    HexRingCursor(const HexAxialPosition& center, int radius)
+    :m_pos(center.Q() - radius, center.R())
+    ,m_radius(radius)
+    ,m_side((radius < 0) ? HexMapPosition::NeighborCount : 0)
+    ,m_step(0)
+    {}
+
+    /// 走査中であるか否か
+    bool IsValid() const { return m_side < HexMapPosition::NeighborCount; }
+
+    /// 現在の位置取得
+    HexMapPosition Get() const { return m_pos.ToOffset(); }
+
+    /// 次の位置へ進む
+    void Next()
+    {
+        if (m_radius == 0) {
+            m_side = HexMapPosition::NeighborCount;
+            return;
+        }
+        m_pos = m_pos.GetNeighbor(static_cast<HexMapPosition::Neighbor>(m_side));
+        if (++m_step == m_radius) {
+            m_step = 0;
+            ++m_side;
+        }
+    }
+
+private:
+    HexAxialPosition m_pos; /// 現在の位置
+    int m_radius;           /// 半径
+    int m_side;             /// 辿っている辺 HexMapPosition::Neighbor
+    int m_step;             /// 辺の上の歩数
+};
+
+/// @class 範囲内の位置の走査
+/// HexAxialPosition::Rangeと同じ順に, q座標の差ごとにr座標の差を小さい順に辿る
+class HexFilledCursor
+{
+public:
+    /// コンストラクタ
+    /// 走査を終えた状態を作る
+    HexFilledCursor()
+    :m_center()
+    ,m_radius(-1)
+    ,m_dq(0)
+    ,m_dr(0)
+    {}
+
+    /// コンストラクタ
+    /// @param center [in] 中心
+    /// @param radius [in] 半径 負ならば空
+    HexFilledCursor(const HexAxialPosition& center, int radius)
+    :m_center(center)
+    ,m_radius(radius)
+    ,m_dq(-radius)
+    ,m_dr(minR(-radius))
+    {}
+
+    /// 走査中であるか否か
+    bool IsValid() const { return (0 <= m_radius) && (m_dq <= m_radius); }
+
+    /// 現在の位置取得
+    HexMapPosition Get() const { return HexAxialPosition(m_center.Q() + m_dq, m_center.R() + m_dr).ToOffset(); }
+
+    /// 次の位置へ進む
+    void Next()
+    {
+        if (++m_dr <= maxR(m_dq)) { return; }
+        ++m_dq;
+        m_dr = minR(m_dq);
+    }
+
+private:
+    /// q座標の差ごとのr座標の差の範囲
+    int minR(int dq) const { return std::max(-m_radius, -dq - m_radius); }
+    int maxR(int dq) const { return std::min(m_radius, -dq + m_radius); }
+
+    HexAxialPosition m_center; /// 中心
+    int m_radius;              /// 半径
+    int m_dq;                  /// 中心からのq座標の差
+    int m_dr;                  /// 中心からのr座標の差
+};
+
+/// @class 渦巻き順の走査
+/// 中心から半径の小さい環の順に辿る 中心からの距離の順に並ぶ
+class HexSpiralCursor
+{
+public:
+    /// コンストラクタ
+    /// 走査を終えた状態を作る
+    HexSpiralCursor()
+    :m_center()
+    ,m_radius(-1)
+    ,m_ring()
+    ,m_ring_radius(0)
+    {}
+
+    /// コンストラクタ
+    /// @param center [in] 中心
+    /// @param radius [in] 半径 負ならば空
+    HexSpiralCursor(const HexAxialPosition& center, int radius)
+    :m_center(center)
+    ,m_radius(radius)
+    ,m_ring(center, (radius < 0) ? -1 : 0)
+    ,m_ring_radius(0)
+    {}
+
+    /// 走査中であるか否か
+    bool IsValid() const { return m_ring.IsValid(); }
+
+    /// 現在の位置取得
+    HexMapPosition Get() const { return m_ring.Get(); }
+
+    /// 次の位置へ進む
+    void Next()
+    {
+        m_ring.Next();
+        if (m_ring.IsValid() || (m_radius <= m_ring_radius)) { return; }
+        ++m_ring_radius;
+        m_ring = HexRingCursor(m_center, m_ring_radius);
+    }
+
+private:
+    HexAxialPosition m_center; /// 中心
+    int m_radius;              /// 半径
+    HexRingCursor m_ring;      /// 辿っている環
+    int m_ring_radius;         /// 辿っている環の半径
+};
+
+/// @class 矩形の位置の走査
+/// 行順に辿る
+class HexRectCursor
+{
+public:
+    /// コンストラクタ
+    /// 走査を終えた状態を作る
+    HexRectCursor()
+    :m_left(0)
+    ,m_right(0)
+    ,m_bottom(0)
+    ,m_x(0)
+    ,m_y(0)
+    {}
+
+    /// コンストラクタ
+    /// @param left [in] 左端のx位置
+    /// @param top [in] 上端のy位置
+    /// @param width [in] 幅 0以下ならば空
+    /// @param height [in] 高さ 0以下ならば空
+    HexRectCursor(int left, int top, int width, int height)
+    :m_left(left)
+    ,m_right(left + width)
+    ,m_bottom(top + height)
+    ,m_x(left)
+    ,m_y(top)
+    {
+        if (width <= 0) { m_y = m_bottom = top; }
+    }
+
+    /// 走査中であるか否か
+    bool IsValid() const { return m_y < m_bottom; }
+
+    /// 現在の位置取得
+    HexMapPosition Get() const { return HexMapPosition(m_x, m_y); }
+
+    /// 次の位置へ進む
+    void Next()
+    {
+        if (++m_x < m_right) { return; }
+        m_x = m_left;
+        ++m_y;
+    }
+
+private:
+    int m_left;   /// 左端
+    int m_right;  /// 右端の次
+    int m_bottom; /// 下端の次
+    int m_x;      /// 現在のx位置
+    int m_y;      /// 現在のy位置
+};
+
+/// @class 線分上の位置の走査
+/// 立方座標で線形補間して丸める 辺の上で丸めが揺れないよう, 補間した位置をわずかにずらす
+/// 始点から終点まで距離+1個の位置を辿る
+class HexLineCursor
+{
+public:
+    /// コンストラクタ
+    /// 走査を終えた状態を作る
+    HexLineCursor()
+    :m_from()
+    ,m_to()
+    ,m_distance(-1)
+    ,m_step(0)
+    {}
+
+    /// コンストラクタ
+    /// @param from [in] 始点
+    /// @param to [in] 終点
+    HexLineCursor(const HexAxialPosition& from, const HexAxialPosition& to)
+    :m_from(from)
+    ,m_to(to)
+    ,m_distance(HexAxialPosition::Distance(from, to))
+    ,m_step(0)
+    {}
+
+    /// 走査中であるか否か
+    bool IsValid() const { return m_step <= m_distance; }
+
+    /// 現在の位置取得
+    HexMapPosition Get() const
+    {
+        if (m_step == 0) { return m_from.ToOffset(); }
+        const HexCubeFraction f = HexAxialPosition::Lerp(m_from, m_to, static_cast<double>(m_step) / m_distance);
+        const HexCubeFraction nudged(f.q + 1e-6, f.r + 2e-6, f.s - 3e-6);
+        return HexAxialPosition::Round(nudged).ToOffset();
+    }
+
+    /// 次の位置へ進む
+    void Next() { ++m_step; }
+
+    /// 始点から終点までの距離取得
+    int GetDistance() const { return m_distance; }
+    /// 始点からの歩数取得
+    int GetStep() const { return m_step; }
+
+private:
+    HexAxialPosition m_from; /// 始点
+    HexAxialPosition m_to;   /// 終点
+    int m_distance;          /// 始点から終点までの距離 走査を終えた状態では-1
+    int m_step;              /// 始点からの歩数
+};
+
+
+/// @class 位置の範囲の前方向イテレータ
+/// 走査をその場で進め, 位置を一つだけ持つ マップの大きさを与えればマップ外の位置を読み飛ばす
+/// @tparam Cursor 走査 IsValid(), Get(), Next()を持つ
+template <class Cursor>
+class HexPositionRangeIterator
+{
+public:
+    /// イテレータ特性
+    typedef std::forward_iterator_tag iterator_category;
+    typedef HexMapPosition value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const HexMapPosition* pointer;
+    typedef const HexMapPosition& reference;
+
+    /// コンストラクタ
+    /// 終端を作る
+    HexPositionRangeIterator()
+    :m_cursor()
+    ,m_pos()
+    ,m_width(-1)
+    ,m_height(-1)
+    ,m_index(-1)
+    {}
+
+    /// コンストラクタ
+    /// @param cursor [in] 走査の開始状態
+    /// @param width [in] マップの幅 負ならばマップ外を読み飛ばさない
+    /// @param height [in] マップの高さ
+    HexPositionRangeIterator(const Cursor& cursor, int width, int height)
+    :m_cursor(cursor)
+    ,m_pos()
+    ,m_width(width)
+    ,m_height(height)
+    ,m_index(0)
+    {
+        settle();
+    }
+
+    /// 参照外し
+    const HexMapPosition& operator*() const { return m_pos; }
+    /// メンバアクセス
+    const HexMapPosition* operator->() const { return &m_pos; }
+
+    /// 一致比較
+    /// 同じ範囲から作ったイテレータ同士を比べること
+    bool operator==(const HexPositionRangeIterator<Cursor>& tgt) const { return m_index == tgt.m_index; }
+    /// 非一致比較
+    bool operator!=(const HexPositionRangeIterator<Cursor>& tgt) const { return m_index != tgt.m_index; }
+
+    /// インクリメント
+    HexPositionRangeIterator<Cursor>& operator++()
+    {
+        m_cursor.Next();
+        ++m_index;
+        settle();
+        return *this;
+    }
+
+    /// 後置インクリメント
+    HexPositionRangeIterator<Cursor> operator++(int)
+    {
+        const HexPositionRangeIterator<Cursor> previous(*this);
+        ++*this;
+        return previous;
+    }
+
+private:
+    /// マップ内の位置まで進める 尽きたら終端になる
+    void settle()
+    {
+        for (; m_cursor.IsValid(); m_cursor.Next(), ++m_index) {
+            m_pos = m_cursor.Get();
+            if (m_width < 0) { return; }
+            if ((0 <= m_pos.X()) && (0 <= m_pos.Y()) && (m_pos.X() < m_width) && (m_pos.Y() < m_height)) { return; }
+        }
+        m_index = -1;
+    }
+
+    Cursor m_cursor;      /// 走査
+    HexMapPosition m_pos; /// 現在の位置
+    int m_width;          /// マップの幅 負ならば読み飛ばさない
+    int m_height;         /// マップの高さ
+    int m_index;          /// 走査の歩数 終端は-1
+};
+
+/// @class 位置の範囲
+/// 範囲forや標準アルゴリズムにbegin(), end()を渡して使う 位置の一覧は作らない
+/// @tparam Cursor 走査
+template <class Cursor>
+class HexPositionRange
+{
+public:
+    typedef HexPositionRangeIterator<Cursor> iterator;
+    typedef HexPositionRangeIterator<Cursor> const_iterator;
+
+    /// コンストラクタ
+    /// @param cursor [in] 走査の開始状態
+    /// @param width [in] マップの幅 負ならばマップ外を読み飛ばさない
+    /// @param height [in] マップの高さ
+    HexPositionRange(const Cursor& cursor, int width, int height)
+    :m_cursor(cursor)
+    ,m_width(width)
+    ,m_height(height)
+    {}
+
+    iterator begin() const { return iterator(m_cursor, m_width, m_height); }
+    iterator end()   const { return iterator(); }
+
+    /// 空であるか否か
+    bool Empty() const { return begin() == end(); }
+
+private:
+    Cursor m_cursor; /// 走査の開始状態
+    int m_width;     /// マップの幅
+    int m_height;    /// マップの高さ
+};
+
+
+/// 環の位置の範囲を取得
+/// @param center [in] 中心
+/// @param radius [in] 半径
+inline HexPositionRange<HexRingCursor> HexRingRange(const HexMapPosition& center, int radius)
+{
+    return HexPositionRange<HexRingCursor>(HexRingCursor(HexAxialPosition::FromOffset(center), radius), -1, -1);
+}
+
+/// マップ内の環の位置の範囲を取得
+/// @tparam Map GetWidth(), GetHeight()を持つマップ
+/// @param center [in] 中心
+/// @param radius [in] 半径
+/// @param map [in] マップ この外の位置は読み飛ばす
+template <class Map>
+HexPositionRange<HexRingCursor> HexRingRange(const HexMapPosition& center, int radius, const Map& map)
+{
+    return HexPositionRange<HexRingCursor>(HexRingCursor(HexAxialPosition::FromOffset(center), radius), map.GetWidth(), map.GetHeight());
+}
+
+/// 範囲内の位置の範囲を取得
+/// @param center [in] 中心
+/// @param radius [in] 半径
+inline HexPositionRange<HexFilledCursor> HexFilledRange(const HexMapPosition& center, int radius)
+{
+    return HexPositionRange<HexFilledCursor>(HexFilledCursor(HexAxialPosition::FromOffset(center), radius), -1, -1);
+}
+
+/// マップ内の範囲内の位置の範囲を取得
+/// @tparam Map GetWidth(), GetHeight()を持つマップ
+/// @param center [in] 中心
+/// @param radius [in] 半径
+/// @param map [in] マップ この外の位置は読み飛ばす
+template <class Map>
+HexPositionRange<HexFilledCursor> HexFilledRange(const HexMapPosition& center, int radius, const Map& map)
+{
+    return HexPositionRange<HexFilledCursor>(HexFilledCursor(HexAxialPosition::FromOffset(center), radius), map.GetWidth(), map.GetHeight());
+}
+
+/// 渦巻き順の位置の範囲を取得
+/// @param center [in] 中心
+/// @param radius [in] 半径
+inline HexPositionRange<HexSpiralCursor> HexSpiralRange(const HexMapPosition& center, int radius)
+{
+    return HexPositionRange<HexSpiralCursor>(HexSpiralCursor(HexAxialPosition::FromOffset(center), radius), -1, -1);
+}
+
+/// マップ内の渦巻き順の位置の範囲を取得
+/// @tparam Map GetWidth(), GetHeight()を持つマップ
+/// @param center [in] 中心
+/// @param radius [in] 半径
+/// @param map [in] マップ この外の位置は読み飛ばす
+template <class Map>
+HexPositionRange<HexSpiralCursor> HexSpiralRange(const HexMapPosition& center, int radius, const Map& map)
+{
+    return HexPositionRange<HexSpiralCursor>(HexSpiralCursor(HexAxialPosition::FromOffset(center), radius), map.GetWidth(), map.GetHeight());
+}
+
+/// 矩形の位置の範囲を取得
+/// @param left [in] 左端のx位置
+/// @param top [in] 上端のy位置
+/// @param width [in] 幅
+/// @param height [in] 高さ
+inline HexPositionRange<HexRectCursor> HexRectRange(int left, int top, int width, int height)
+{
+    return HexPositionRange<HexRectCursor>(HexRectCursor(left, top, width, height), -1, -1);
+}
+
+/// マップで切り取った矩形の位置の範囲を取得
+/// 矩形をマップと重なる部分に縮めるので, マップ外の位置を辿らない
+/// @tparam Map GetWidth(), GetHeight()を持つマップ
+/// @param left [in] 左端のx位置
+/// @param top [in] 上端のy位置
+/// @param width [in] 幅
+/// @param height [in] 高さ
+/// @param map [in] マップ
+template <class Map>
+HexPositionRange<HexRectCursor> HexRectRange(int left, int top, int width, int height, const Map& map)
+{
+    const int x0 = std::max(left, 0);
+    const int y0 = std::max(top, 0);
+    const int x1 = std::min(left + width, map.GetWidth());
+    const int y1 = std::min(top + height, map.GetHeight());
+    return HexPositionRange<HexRectCursor>(HexRectCursor(x0, y0, x1 - x0, y1 - y0), -1, -1);
+}
+
+/// 線分上の位置の範囲を取得
+/// @param a [in] 始点
+/// @param b [in] 終点
+inline HexPositionRange<HexLineCursor> HexLineRange(const HexMapPosition& a, const HexMapPosition& b)
+{
+    return HexPositionRange<HexLineCursor>(HexLineCursor(HexAxialPosition::FromOffset(a), HexAxialPosition::FromOffset(b)), -1, -1);
+}
+
+#endif
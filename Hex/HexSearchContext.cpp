@@ -0,0 +1,79 @@
+//
+//  HexSearchContext.cpp
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#include "HexSearchContext.h"
+
+#include <algorithm>
+
+/// コンストラクタ
+HexSearchContext::HexSearchContext()
+:m_own_arena()
+,m_arena(m_own_arena)
+,m_width(-1)
+,m_height(-1)
+,m_touched(0)
+,m_stamp(NULL)
+,m_distance(NULL)
+,m_parent(NULL)
+,m_queue(NULL)
+,m_generation(0)
+,m_open()
+{}
+
+/// コンストラクタ
+HexSearchContext::HexSearchContext(HexArena& arena)
+:m_own_arena(0)
+,m_arena(arena)
+,m_width(-1)
+,m_height(-1)
+,m_touched(0)
+,m_stamp(NULL)
+,m_distance(NULL)
+,m_parent(NULL)
+,m_queue(NULL)
+,m_generation(0)
+,m_open()
+{}
+
+/// 位置ごとの配列を捨てる
+void HexSearchContext::Invalidate()
+{
+    m_width    = -1;
+    m_height   = -1;
+    m_touched  = 0;
+    m_stamp    = NULL;
+    m_distance = NULL;
+    m_parent   = NULL;
+    m_queue    = NULL;
+}
+
+/// 探索を始める
+void HexSearchContext::prepare(int width, int height)
+{
+    if ((width != m_width) || (height != m_height)) {
+        // 自身の領域ならば前の配列ごと巻き戻す
+        if (&m_arena == &m_own_arena) { m_own_arena.Reset(); }
+        const std::size_t size = static_cast<std::size_t>(width) * height;
+        m_stamp    = m_arena.AllocateArray<uint32_t>(size);
+        m_distance = m_arena.AllocateArray<int>(size);
+        m_parent   = m_arena.AllocateArray<int>(size);
+        m_queue    = m_arena.AllocateArray<int>(size);
+        std::fill(m_stamp, m_stamp + size, 0u);
+        m_width      = width;
+        m_height     = height;
+        m_generation = 0;
+    }
+
+    // 世代が一周したら全位置の世代を消す
+    if (++m_generation == 0) {
+        std::fill(m_stamp, m_stamp + static_cast<std::size_t>(m_width) * m_height, 0u);
+        m_generation = 1;
+    }
+    m_touched = 0;
+    m_open.Clear();
+}
@@ -0,0 +1,273 @@
+//
+//  HexSearchContext.h
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#ifndef Hex_HexSearchContext_h
+#define Hex_HexSearchContext_h
+
+#include "HexArena.h"
+#include "HexMap.h"
+#include "HexMoveCost.h"
+#include "HexPathFinder.h"
+#include "HexRadixHeap.h"
+
+#include <algorithm>
+#include <cassert>
+#include <stdint.h>
+#include <vector>
+
+/// @class 経路探索の作業領域
+/// 位置ごとのコスト, 一つ手前の位置, 世代を持ち, 探索のたびに世代を進めて前の結果を無効にする
+/// 触れた位置だけに書き込むので, 探索の手間はマップの大きさによらず探索した範囲に比例する
+/// 位置ごとの配列はメモリ領域から確保し, 待ち行列も使い回すので, 同じ大きさのマップで探索を続ければメモリを確保しない
+/// 探索結果は次の探索まで有効
+class HexSearchContext
+{
+public:
+    /// コンストラクタ
+    /// 位置ごとの配列は自身のメモリ領域から確保する
+    HexSearchContext();
+
+    /// コンストラクタ
+    /// 位置ごとの配列は与えたメモリ領域から確保する
+    /// マップの大きさが変わるたびに確保し直すので, 領域の巻き戻しは呼び出し側で行い, 巻き戻したらInvalidate()を呼ぶこと
+    /// @param arena [in] メモリ領域 この作業領域より長く生存すること
+    explicit HexSearchContext(HexArena& arena);
+
+    /// 位置ごとの配列を捨てる
+    /// 次の探索で確保し直す
+    void Invalidate();
+
+    /// 移動コストを考慮した探索 (A*)
+    /// SearchPathMapと同じ探索を作業領域の上で行う
+    /// @param map [in] ヘックスマップ
+    /// @param cost [in] 移動コスト表
+    /// @param start [in] 開始地点
+    /// @param goal [in] 目標地点 NULLならばマップ全体を探索する
+    /// @param heuristic [in] 目標地点までのコストの推定値
+    /// @retval 目標地点までのコスト 到達できなければPathDistanceUnreachable 目標地点がNULLならば到達できた位置の数
+    template <int Width, int Height, class Heuristic>
+    int Search(const HexMap<HexChip, Width, Height>& map,
+               const HexMoveCost& cost,
+               const HexMapPosition& start,
+               const HexMapPosition* goal,
+               const Heuristic& heuristic)
+    {
+        prepare(map.GetWidth(), map.GetHeight());
+        if (! IsEntriable(map, cost, start)) { return (goal != NULL) ? PathDistanceUnreachable : 0; }
+
+        int reached(0);
+        const int start_index = indexOf(start);
+        touch(start_index, 0, start_index);
+        m_open.Push(heuristic(start), start_index);
+
+        while (! m_open.Empty()) {
+            const HexRadixHeap<int>::Entry entry = m_open.Pop();
+            const int index = entry.second;
+            const HexMapPosition pivot = positionOf(index);
+            const int current = m_distance[index];
+
+            // より小さいコストで積み直された古い要素は読み飛ばす
+            if (static_cast<int>(entry.first) != current + heuristic(pivot)) { continue; }
+            ++reached;
+            if ((goal != NULL) && (pivot == *goal)) { return current; }
+
+            for (int i(0); i < HexMapPosition::NeighborCount; ++i) {
+                const HexMapPosition candidate = pivot.GetNeighbor(static_cast<HexMapPosition::Neighbor>(i));
+                if (! IsEntriable(map, cost, candidate)) { continue; }
+
+                const int candidate_index = indexOf(candidate);
+                const int next = current + cost(map[candidate]);
+                if (isTouched(candidate_index) && (m_distance[candidate_index] <= next)) { continue; }
+
+                touch(candidate_index, next, index);
+                m_open.Push(next + heuristic(candidate), candidate_index);
+            }
+        }
+        return (goal != NULL) ? PathDistanceUnreachable : reached;
+    }
+
+    /// 歩数の幅優先探索
+    /// GeneratePathMapと同じ探索を作業領域の上で行う
+    /// @param map [in] ヘックスマップ
+    /// @param start [in] 開始地点
+    /// @param goal [in] 目標地点 NULLならばマップ全体を探索する
+    /// @retval 目標地点までの歩数 到達できなければPathDistanceUnreachable 目標地点がNULLならば到達できた位置の数
+    template <int Width, int Height>
+    int Breadth(const HexMap<HexChip, Width, Height>& map,
+                const HexMapPosition& start,
+                const HexMapPosition* goal)
+    {
+        prepare(map.GetWidth(), map.GetHeight());
+        if (! IsEntriable(map, start)) { return (goal != NULL) ? PathDistanceUnreachable : 0; }
+
+        /// 各位置は一度しか積まれないので, 配列をそのまま待ち行列として使う
+        int tail(0);
+        const int start_index = indexOf(start);
+        touch(start_index, 0, start_index);
+        m_queue[tail++] = start_index;
+
+        for (int head(0); head < tail; ++head) {
+            const int index = m_queue[head];
+            const HexMapPosition pivot = positionOf(index);
+            if ((goal != NULL) && (pivot == *goal)) { return m_distance[index]; }
+
+            const int next = m_distance[index] + 1;
+            for (int i(0); i < HexMapPosition::NeighborCount; ++i) {
+                const HexMapPosition candidate = pivot.GetNeighbor(static_cast<HexMapPosition::Neighbor>(i));
+                if (! IsEntriable(map, candidate)) { continue; }
+
+                const int candidate_index = indexOf(candidate);
+                if (isTouched(candidate_index)) { continue; }
+                touch(candidate_index, next, index);
+                m_queue[tail++] = candidate_index;
+            }
+        }
+        return (goal != NULL) ? PathDistanceUnreachable : tail;
+    }
+
+    /// 直前の探索で到達したか否か
+    /// @param pos [in] 位置
+    bool IsReached(const HexMapPosition& pos) const { return contains(pos) && isTouched(indexOf(pos)); }
+
+    /// 直前の探索のコスト取得
+    /// @param pos [in] 位置
+    /// @retval コスト 到達していない位置と侵入不可の位置はPathDistanceUnreachable
+    int GetDistance(const HexMapPosition& pos) const
+    {
+        return IsReached(pos) ? m_distance[indexOf(pos)] : static_cast<int>(PathDistanceUnreachable);
+    }
+
+    /// 直前の探索の一つ手前の位置取得
+    /// @param pos [in] 位置
+    /// @retval 一つ手前の位置 開始地点と到達していない位置は自身
+    HexMapPosition GetParent(const HexMapPosition& pos) const
+    {
+        return IsReached(pos) ? positionOf(m_parent[indexOf(pos)]) : pos;
+    }
+
+    /// 直前の探索の経路取得
+    /// @param goal [in] 目標地点
+    /// @param path [out] 開始地点から目標地点までの位置 到達していなければ空 確保済みの領域を使い回す
+    /// @retval 経路の位置の数
+    int GetPath(const HexMapPosition& goal, std::vector<HexMapPosition>& path) const
+    {
+        path.clear();
+        if (! IsReached(goal)) { return 0; }
+        for (int index = indexOf(goal); ; index = m_parent[index]) {
+            path.push_back(positionOf(index));
+            if (m_parent[index] == index) { break; }
+        }
+        std::reverse(path.begin(), path.end());
+        return static_cast<int>(path.size());
+    }
+
+    /// 直前の探索で触れた位置の数取得
+    int GetTouchedCount() const { return m_touched; }
+    /// 幅取得
+    int GetWidth() const { return m_width; }
+    /// 高さ取得
+    int GetHeight() const { return m_height; }
+
+private:
+    /// 探索を始める
+    /// 大きさが変われば位置ごとの配列を確保し直し, 世代を進める
+    void prepare(int width, int height);
+
+    /// 位置に書き込む
+    void touch(int index, int distance, int parent)
+    {
+        if (m_stamp[index] != m_generation) {
+            m_stamp[index] = m_generation;
+            ++m_touched;
+        }
+        m_distance[index] = distance;
+        m_parent[index]   = parent;
+    }
+
+    /// 今の世代で書き込んだか否か
+    bool isTouched(int index) const { return m_stamp[index] == m_generation; }
+
+    /// マップ内であるか否か
+    bool contains(const HexMapPosition& pos) const
+    {
+        return (0 <= pos.X()) && (0 <= pos.Y()) && (pos.X() < m_width) && (pos.Y() < m_height);
+    }
+
+    /// 位置から添字を取得
+    int indexOf(const HexMapPosition& pos) const { return pos.X() + m_width * pos.Y(); }
+    /// 添字から位置を取得
+    HexMapPosition positionOf(int index) const { return HexMapPosition(index % m_width, index / m_width); }
+
+    // コピー禁止
+    HexSearchContext(const HexSearchContext&);
+    HexSearchContext& operator=(const HexSearchContext&);
+
+    HexArena  m_own_arena; /// 自身のメモリ領域
+    HexArena& m_arena;     /// 位置ごとの配列を確保するメモリ領域
+
+    int m_width;    /// 幅 未確保ならば-1
+    int m_height;   /// 高さ 未確保ならば-1
+    int m_touched;  /// 触れた位置の数
+
+    uint32_t* m_stamp;      /// 位置ごとの世代
+    int*      m_distance;   /// 位置ごとのコスト
+    int*      m_parent;     /// 位置ごとの一つ手前の位置の添字
+    int*      m_queue;      /// 幅優先探索の待ち行列
+    uint32_t  m_generation; /// 世代
+
+    HexRadixHeap<int> m_open; /// A*の待ち行列 バケットの領域は使い回す
+};
+
+
+/// 作業領域を使って二点間の経路を探索する (A*)
+/// FindPathと同じ結果を作業領域に残す
+/// @param map [in] ヘックスマップ
+/// @param cost [in] 移動コスト表
+/// @param start [in] 開始地点
+/// @param goal [in] 目標地点
+/// @param context [in,out] 作業領域 経路はGetPath()で取り出す
+/// @retval 目標地点までのコスト 到達できなければPathDistanceUnreachable
+template <int Width, int Height>
+int FindPath(const HexMap<HexChip, Width, Height>& map,
+             const HexMoveCost& cost,
+             const HexMapPosition& start,
+             const HexMapPosition& goal,
+             HexSearchContext& context)
+{
+    return context.Search(map, cost, start, &goal, HexDistanceHeuristic(goal, cost));
+}
+
+/// 作業領域を使って移動コストを考慮したコストマップを生成する (ダイクストラ法)
+/// @param map [in] ヘックスマップ
+/// @param cost [in] 移動コスト表
+/// @param start [in] 開始地点
+/// @param context [in,out] 作業領域 コストはGetDistance()で取り出す
+/// @retval 到達できた位置の数
+template <int Width, int Height>
+int GenerateCostMap(const HexMap<HexChip, Width, Height>& map,
+                    const HexMoveCost& cost,
+                    const HexMapPosition& start,
+                    HexSearchContext& context)
+{
+    return context.Search(map, cost, start, static_cast<const HexMapPosition*>(NULL), HexZeroHeuristic());
+}
+
+/// 作業領域を使って歩数の経路マップを生成する
+/// @param map [in] ヘックスマップ
+/// @param start [in] 開始地点
+/// @param context [in,out] 作業領域 歩数はGetDistance(), 経路はGetParent()で取り出す
+/// @retval 到達できた位置の数
+template <int Width, int Height>
+int GeneratePathMap(const HexMap<HexChip, Width, Height>& map,
+                    const HexMapPosition& start,
+                    HexSearchContext& context)
+{
+    return context.Breadth(map, start, static_cast<const HexMapPosition*>(NULL));
+}
+
+#endif
@@ -0,0 +1,324 @@
+//
+//  HexSparseMap.h
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#ifndef Hex_HexSparseMap_h
+#define Hex_HexSparseMap_h
+
+#include "HexChip.h"
+#include "HexMapPosition.h"
+
+#include <stdint.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// @class 範囲を持たない疎なヘックスマップ
+/// マップを一辺 2^ChunkShift マスの正方形のチャンクに分け, 初めて書き込んだときにチャンクを確保する
+/// 確保していない位置は既定値を返すので, メモリは書き込んだ範囲にだけ比例する
+/// 座標は負でもよい チャンクの座標は算術シフトで求めるので, -1 は -16 から -1 のチャンクに入る
+/// 読み取りでも直前に引いたチャンクと使用時刻を書き換えるので, 複数のスレッドから同時に引いてはならない
+/// @tparam T ヘックスマップで保持する値
+/// @tparam ChunkShift チャンクの一辺の二進桁数
+template <class T, int ChunkShift = 4>
+class HexSparseMap
+{
+public:
+    /// チャンクの一辺のマス数
+    static const int ChunkSize = 1 << ChunkShift;
+    /// チャンクのマス数
+    static const int ChunkCellCount = ChunkSize * ChunkSize;
+
+    /// コンストラクタ
+    /// @param default_value [in] 書き込んでいない位置の値
+    explicit HexSparseMap(const T& default_value = T())
+    :m_chunks()
+    ,m_default(default_value)
+    ,m_clock(0)
+    ,m_last_key(0)
+    ,m_last_chunk(NULL)
+    ,m_last_writable_key(0)
+    ,m_last_writable(NULL)
+    {}
+
+    /// コピーコンストラクタ
+    /// 直前に引いたチャンクの記憶は引き継がない
+    HexSparseMap(const HexSparseMap& src)
+    :m_chunks(src.m_chunks)
+    ,m_default(src.m_default)
+    ,m_clock(src.m_clock)
+    ,m_last_key(0)
+    ,m_last_chunk(NULL)
+    ,m_last_writable_key(0)
+    ,m_last_writable(NULL)
+    {}
+
+    /// ムーブコンストラクタ
+    /// 直前に引いたチャンクの記憶は, 移動元のものも含めて消す
+    HexSparseMap(HexSparseMap&& src)
+    :m_chunks(std::move(src.m_chunks))
+    ,m_default(std::move(src.m_default))
+    ,m_clock(src.m_clock)
+    ,m_last_key(0)
+    ,m_last_chunk(NULL)
+    ,m_last_writable_key(0)
+    ,m_last_writable(NULL)
+    {
+        src.forgetLastChunk();
+    }
+
+    /// 代入
+    HexSparseMap& operator=(const HexSparseMap& src)
+    {
+        m_chunks  = src.m_chunks;
+        m_default = src.m_default;
+        m_clock   = src.m_clock;
+        forgetLastChunk();
+        return *this;
+    }
+
+    /// ムーブ代入
+    HexSparseMap& operator=(HexSparseMap&& src)
+    {
+        if (this == &src) { return *this; }
+        m_chunks  = std::move(src.m_chunks);
+        m_default = std::move(src.m_default);
+        m_clock   = src.m_clock;
+        forgetLastChunk();
+        src.forgetLastChunk();
+        return *this;
+    }
+
+    /// 値取得
+    /// チャンクを確保しない 書き込んでいない位置は既定値
+    /// @param pos [in] 位置
+    const T& Get(const HexMapPosition& pos) const
+    {
+        const Chunk* chunk = find(keyOf(pos));
+        return (chunk != NULL) ? chunk->cells[localIndexOf(pos)] : m_default;
+    }
+
+    /// 要素アクセス
+    /// 読み取り専用ならばチャンクを確保しない
+    inline const T& operator[](const HexMapPosition& pos) const { return Get(pos); }
+    /// 要素アクセス
+    /// 書き込み用なのでチャンクがなければ確保する 読むだけならばGetを使う
+    inline T& operator[](const HexMapPosition& pos) { return At(pos); }
+
+    /// 要素アクセス
+    /// チャンクがなければ既定値で埋めて確保し, 使用時刻を更新する
+    /// @param pos [in] 位置
+    T& At(const HexMapPosition& pos)
+    {
+        const uint64_t key = keyOf(pos);
+        Chunk* chunk = findWritable(key);
+        if (chunk == NULL) {
+            chunk = &m_chunks[key];
+            chunk->cells.assign(ChunkCellCount, m_default);
+            chunk->last_used    = m_clock;
+            m_last_writable_key = key;
+            m_last_writable     = chunk;
+        }
+        return chunk->cells[localIndexOf(pos)];
+    }
+
+    /// 値設定
+    /// @param pos [in] 位置
+    /// @param value [in] 値
+    void Set(const HexMapPosition& pos, const T& value) { At(pos) = value; }
+
+    /// 既定値取得
+    const T& GetDefault() const { return m_default; }
+
+    /// 位置を含むチャンクを確保しているか否か
+    /// @param pos [in] 位置
+    bool IsLoaded(const HexMapPosition& pos) const { return find(keyOf(pos)) != NULL; }
+
+    /// 確保しているチャンクの数取得
+    int GetChunkCount() const { return static_cast<int>(m_chunks.size()); }
+
+    /// チャンクの要素が占めるバイト数を取得
+    std::size_t GetByteSize() const { return m_chunks.size() * ChunkCellCount * sizeof(T); }
+
+    /// 使用時刻を取得
+    /// 読み書きで引いたチャンクにこの時刻が記録される
+    unsigned GetClock() const { return m_clock; }
+
+    /// 使用時刻を進める
+    /// @retval 進めた後の時刻
+    unsigned AdvanceClock() { return ++m_clock; }
+
+    /// 位置を含むチャンクを解放する
+    /// 解放した範囲は既定値に戻る
+    /// @param pos [in] 位置
+    /// @retval 解放したならばtrue 確保していなければfalse
+    bool Unload(const HexMapPosition& pos)
+    {
+        forgetLastChunk();
+        return m_chunks.erase(keyOf(pos)) != 0;
+    }
+
+    /// 指定時刻より前から使われていないチャンクを解放する
+    /// 読み取りでも使用時刻は更新されるので, 読み続けているチャンクは解放しない
+    /// 解放した範囲は既定値に戻る 内容を残すには保存処理を受け取る版を使う
+    /// @param clock [in] 時刻 これより前に最後に使われたチャンクを解放する
+    /// @retval 解放したチャンクの数
+    int UnloadUnusedSince(unsigned clock)
+    {
+        return UnloadUnusedSince(clock, IgnoreChunk());
+    }
+
+    /// 指定時刻より前から使われていないチャンクを, 保存処理に渡してから解放する
+    /// @tparam Function void(const HexMapPosition& origin, const T* cells) 要素はチャンク内で行順にChunkCellCount個並ぶ
+    /// @param clock [in] 時刻 これより前に最後に使われたチャンクを解放する
+    /// @param function [in] 解放する直前のチャンクを受け取る処理 チャンクの書き出しなどに使う
+    /// @retval 解放したチャンクの数
+    template <class Function>
+    int UnloadUnusedSince(unsigned clock, Function function)
+    {
+        forgetLastChunk();
+        int count(0);
+        for (typename ChunkTable::iterator it = m_chunks.begin(); it != m_chunks.end(); ) {
+            if (it->second.last_used < clock) {
+                function(originOf(it->first), static_cast<const T*>(&it->second.cells[0]));
+                it = m_chunks.erase(it);
+                ++count;
+            } else {
+                ++it;
+            }
+        }
+        return count;
+    }
+
+    /// 全チャンクを解放する
+    void Clear()
+    {
+        forgetLastChunk();
+        m_chunks.clear();
+    }
+
+    /// 確保しているチャンクを順に処理する
+    /// 順序は決まらない
+    /// @tparam Function void(const HexMapPosition& origin, const T* cells) 要素はチャンク内で行順にChunkCellCount個並ぶ
+    /// @param function [in] 処理
+    template <class Function>
+    void ForEachChunk(Function function) const
+    {
+        for (typename ChunkTable::const_iterator it = m_chunks.begin(); it != m_chunks.end(); ++it) {
+            function(originOf(it->first), &it->second.cells[0]);
+        }
+    }
+
+private:
+    /// チャンク
+    struct Chunk
+    {
+        Chunk()
+        :cells()
+        ,last_used(0)
+        {}
+
+        std::vector<T> cells;        /// 要素 行順
+        mutable unsigned last_used;  /// 最後に読み書きで引いた時刻 読み取りでも書き換える
+    };
+
+    /// 解放するチャンクを捨てる
+    struct IgnoreChunk
+    {
+        void operator()(const HexMapPosition&, const T*) const {}
+    };
+
+    typedef std::unordered_map<uint64_t, Chunk> ChunkTable;
+
+    /// 位置からチャンクの鍵を取得
+    static uint64_t keyOf(const HexMapPosition& pos)
+    {
+        const uint32_t cx = static_cast<uint32_t>(pos.X() >> ChunkShift);
+        const uint32_t cy = static_cast<uint32_t>(pos.Y() >> ChunkShift);
+        return (static_cast<uint64_t>(cx) << 32) | cy;
+    }
+
+    /// チャンクの鍵から左上の位置を取得
+    static HexMapPosition originOf(uint64_t key)
+    {
+        const int cx = static_cast<int32_t>(static_cast<uint32_t>(key >> 32));
+        const int cy = static_cast<int32_t>(static_cast<uint32_t>(key));
+        return HexMapPosition(cx * ChunkSize, cy * ChunkSize);
+    }
+
+    /// チャンク内の添字を取得
+    static int localIndexOf(const HexMapPosition& pos)
+    {
+        const int mask = ChunkSize - 1;
+        return (pos.X() & mask) + ChunkSize * (pos.Y() & mask);
+    }
+
+    /// 読み取るチャンクを探し, 見つかれば使用時刻を更新する
+    /// 同じチャンクを続けて引くことが多いので直前のチャンクを覚えておく
+    /// チャンク表は再配置でチャンクを動かさないので, 覚えたポインタは解放するまで使える
+    const Chunk* find(uint64_t key) const
+    {
+        if ((m_last_chunk == NULL) || (m_last_key != key)) {
+            typename ChunkTable::const_iterator it = m_chunks.find(key);
+            if (it == m_chunks.end()) { return NULL; }
+            m_last_key   = key;
+            m_last_chunk = &it->second;
+        }
+        m_last_chunk->last_used = m_clock;
+        return m_last_chunk;
+    }
+
+    /// 書き込むチャンクを探し, 見つかれば使用時刻を更新する
+    /// 読み取りとは別に直前のチャンクを覚えておく
+    Chunk* findWritable(uint64_t key)
+    {
+        if ((m_last_writable == NULL) || (m_last_writable_key != key)) {
+            typename ChunkTable::iterator it = m_chunks.find(key);
+            if (it == m_chunks.end()) { return NULL; }
+            m_last_writable_key = key;
+            m_last_writable     = &it->second;
+        }
+        m_last_writable->last_used = m_clock;
+        return m_last_writable;
+    }
+
+    /// 直前に引いたチャンクの記憶を消す
+    /// チャンクを解放したり表を入れ替えたりしたら呼ぶ
+    void forgetLastChunk()
+    {
+        m_last_chunk    = NULL;
+        m_last_writable = NULL;
+    }
+
+    /// チャンク表
+    ChunkTable m_chunks;
+    /// 書き込んでいない位置の値
+    T m_default;
+    /// 使用時刻
+    unsigned m_clock;
+
+    mutable uint64_t m_last_key;            /// 直前に読み取ったチャンクの鍵
+    mutable const Chunk* m_last_chunk;      /// 直前に読み取ったチャンク
+    uint64_t m_last_writable_key;           /// 直前に書き込んだチャンクの鍵
+    Chunk* m_last_writable;                 /// 直前に書き込んだチャンク
+};
+
+template <class T, int ChunkShift> const int HexSparseMap<T, ChunkShift>::ChunkSize;
+template <class T, int ChunkShift> const int HexSparseMap<T, ChunkShift>::ChunkCellCount;
+
+
+/// 疎なマップのその位置に侵入可能であるか否かを判定する
+/// 範囲を持たないので, 書き込んでいない位置は既定値で判定する
+/// @param map [in] ヘックスマップ
+/// @param pos [in] 位置
+template <int ChunkShift>
+bool IsEntriable(const HexSparseMap<HexChip, ChunkShift>& map, const HexMapPosition& pos)
+{
+    return (map[pos] != HexChip::NoEntry);
+}
+
+#endif
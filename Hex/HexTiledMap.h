@@ -0,0 +1,441 @@
+//
+//  HexTiledMap.h
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#ifndef Hex_HexTiledMap_h
+#define Hex_HexTiledMap_h
+
+#include "HexMap.h"
+#include "HexMapPosition.h"
+
+#include <cassert>
+#include <iterator>
+#include <vector>
+
+/// @class チャンク分割したヘックスマップ
+/// マップを一辺 2^ChunkShift マスの正方形のチャンクに分け, チャンクの中はモートン順(Z順)に並べる
+/// 上下の隣が同じチャンクの近くに置かれ, チャンク内の隣はチャンクを引き直さずに辿れる
+/// 幅優先探索が行単位のHexMapより速くなるのはキャッシュに収まらない大きさのマップだけで,
+/// 収まる大きさでは添字の計算の分だけ遅い 差はhex_benchのGeneratePathMap(tiled)で確かめられる
+/// 要素アクセスはHexMapと同じ書き方ができる 添字で引けば位置からの変換を省ける
+/// @tparam T ヘックスマップで保持する値
+/// @tparam Width 幅 HexMapDynamicならば実行時に決める
+/// @tparam Height 高さ HexMapDynamicならば実行時に決める
+/// @tparam ChunkShift チャンクの一辺の二進桁数 4で16x16, 5で32x32
+template <class T, int Width, int Height, int ChunkShift = 4>
+class HexTiledMap
+{
+    static_assert((ChunkShift == 4) || (ChunkShift == 5), "chunk must be 16x16 or 32x32");
+
+public:
+    /// チャンクの一辺のマス数
+    static const int ChunkSize = 1 << ChunkShift;
+    /// チャンクのマス数
+    static const int ChunkCellCount = ChunkSize * ChunkSize;
+
+    /// @class チャンク
+    /// マップの端のチャンクはChunkSizeより小さく切り詰められるが, 要素はChunkCellCount個並ぶ
+    /// @tparam Cell 要素型 読み取り専用ならばconst T
+    template <class Cell>
+    class ChunkBase
+    {
+    public:
+        /// コンストラクタ
+        /// @param origin [in] 左上の位置
+        /// @param width [in] マップ内に収まる幅
+        /// @param height [in] マップ内に収まる高さ
+        /// @param cells [in] 要素の先頭
+        ChunkBase(const HexMapPosition& origin, int width, int height, Cell* cells)
+        :m_origin(origin)
+        ,m_width(width)
+        ,m_height(height)
+        ,m_cells(cells)
+        {}
+
+        /// 左上の位置取得
+        const HexMapPosition& GetOrigin() const { return m_origin; }
+        /// マップ内に収まる幅取得
+        int GetWidth() const { return m_width; }
+        /// マップ内に収まる高さ取得
+        int GetHeight() const { return m_height; }
+
+        /// 位置を含むか否か
+        /// @param pos [in] マップ全体での位置
+        bool Contains(const HexMapPosition& pos) const
+        {
+            return (m_origin.X() <= pos.X()) && (pos.X() < m_origin.X() + m_width)
+                && (m_origin.Y() <= pos.Y()) && (pos.Y() < m_origin.Y() + m_height);
+        }
+
+        /// 要素アクセス
+        /// @param pos [in] マップ全体での位置 Containsであること
+        Cell& operator[](const HexMapPosition& pos) const
+        {
+            return m_cells[HexTiledMap::mortonOf(pos.X() - m_origin.X(), pos.Y() - m_origin.Y())];
+        }
+
+        /// モートン順の要素の先頭取得
+        /// マップの外にはみ出す要素を含めてChunkCellCount個並ぶ
+        Cell* GetCells() const { return m_cells; }
+
+        /// モートン順の添字から位置を取得
+        /// @param index [in] 添字
+        /// @retval マップ全体での位置 マップの外にはみ出す場合もある
+        HexMapPosition PositionOf(int index) const
+        {
+            return HexMapPosition(m_origin.X() + HexTiledMap::compact(index), m_origin.Y() + HexTiledMap::compact(index >> 1));
+        }
+
+    private:
+        HexMapPosition m_origin; /// 左上の位置
+        int m_width;             /// マップ内に収まる幅
+        int m_height;            /// マップ内に収まる高さ
+        Cell* m_cells;           /// 要素の先頭
+    };
+
+    typedef ChunkBase<T>       Chunk;
+    typedef ChunkBase<const T> ConstChunk;
+
+    /// @class チャンクを左上から行順に辿るイテレータ
+    /// @tparam Map マップ型 読み取り専用ならばconst HexTiledMap
+    /// @tparam Value チャンク型
+    template <class Map, class Value>
+    class ChunkIteratorBase
+    {
+    public:
+        /// イテレータ特性
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Value                     value_type;
+        typedef std::ptrdiff_t            difference_type;
+        typedef void                      pointer;
+        typedef Value                     reference;
+
+        /// コンストラクタ
+        /// @param map [in] マップ
+        /// @param index [in] チャンクの番号
+        ChunkIteratorBase(Map& map, int index)
+        :m_map(&map)
+        ,m_index(index)
+        {}
+
+        /// チャンク取得
+        Value operator*() const { return m_map->GetChunk(m_index); }
+
+        /// 前置インクリメント
+        ChunkIteratorBase& operator++()
+        {
+            ++m_index;
+            return *this;
+        }
+
+        /// 後置インクリメント
+        ChunkIteratorBase operator++(int)
+        {
+            ChunkIteratorBase prev = *this;
+            ++m_index;
+            return prev;
+        }
+
+        /// 一致比較
+        bool operator==(const ChunkIteratorBase& tgt) const { return m_index == tgt.m_index; }
+        /// 非一致比較
+        bool operator!=(const ChunkIteratorBase& tgt) const { return m_index != tgt.m_index; }
+
+    private:
+        Map* m_map;  /// マップ
+        int m_index; /// チャンクの番号
+    };
+
+    typedef ChunkIteratorBase<HexTiledMap, Chunk>            ChunkIterator;
+    typedef ChunkIteratorBase<const HexTiledMap, ConstChunk> ConstChunkIterator;
+
+    /// コンストラクタ
+    HexTiledMap()
+    :m_width(0)
+    ,m_height(0)
+    ,m_chunk_columns(0)
+    ,m_chunk_rows(0)
+    ,m_cells()
+    {
+        if ((Width != HexMapDynamic) && (Height != HexMapDynamic)) { resize(Width, Height); }
+    }
+
+    /// コンストラクタ
+    /// @param width [in] 幅 Widthが固定ならば一致すること
+    /// @param height [in] 高さ Heightが固定ならば一致すること
+    HexTiledMap(int width, int height)
+    :m_width(0)
+    ,m_height(0)
+    ,m_chunk_columns(0)
+    ,m_chunk_rows(0)
+    ,m_cells()
+    {
+        assert((Width == HexMapDynamic) || (width == Width));
+        assert((Height == HexMapDynamic) || (height == Height));
+        resize(width, height);
+    }
+
+    /// 要素アクセス
+    inline       T& operator[](const HexMapPosition& pos)       { return At(pos); }
+    inline const T& operator[](const HexMapPosition& pos) const { return At(pos); }
+
+    /// 要素アクセス
+    inline       T& At(const HexMapPosition& pos)       { return m_cells[IndexOf(pos)]; }
+    inline const T& At(const HexMapPosition& pos) const { return m_cells[IndexOf(pos)]; }
+
+    /// 添字による要素アクセス
+    /// @param index [in] IndexOf()やGetNeighborBits()で求めた添字
+    inline       T& AtIndex(int index)       { return m_cells[index]; }
+    inline const T& AtIndex(int index) const { return m_cells[index]; }
+
+    /// 位置から要素の添字を取得
+    /// 大きさとChunkShiftが同じマップでは同じ位置が同じ添字になる
+    /// @param pos [in] 位置 マップ内であること
+    int IndexOf(const HexMapPosition& pos) const
+    {
+        const int mask  = ChunkSize - 1;
+        const int chunk = (pos.X() >> ChunkShift) + m_chunk_columns * (pos.Y() >> ChunkShift);
+        return (chunk << (2 * ChunkShift)) | mortonOf(pos.X() & mask, pos.Y() & mask);
+    }
+
+    /// チャンク内の隣の添字の成分を求める
+    /// モートン順の添字のx, yのビットをそれぞれ一つおきの整数として足し引きする
+    /// 隣の添字は (index & ~(ChunkCellCount - 1)) | columns[dx + 1] | rows[dy + 1] で求まる
+    /// チャンクの端を越える成分は折り返した値になるので, 呼び出し側で範囲を判定すること
+    /// @param index [in] 添字
+    /// @param columns [out] x-1, x, x+1 のxのビット
+    /// @param rows [out] y-1, y, y+1 のyのビット
+    static void GetNeighborBits(int index, int columns[3], int rows[3])
+    {
+        const int x_bits = spread(ChunkSize - 1);
+        const int y_bits = x_bits << 1;
+        const int x = index & x_bits;
+        const int y = index & y_bits;
+        columns[0] = (x - 1) & x_bits;
+        columns[1] = x;
+        columns[2] = ((x | y_bits) + 1) & x_bits;
+        rows[0]    = (y - 2) & y_bits;
+        rows[1]    = y;
+        rows[2]    = ((y | x_bits) + 2) & y_bits;
+    }
+
+    /// 幅取得
+    inline int GetWidth()  const { return m_width; }
+    /// 高さ取得
+    inline int GetHeight() const { return m_height; }
+    /// 大きさ取得
+    inline int Size() const { return m_width * m_height; }
+
+    /// 大きさ変更
+    /// 要素はすべて初期値に戻る 大きさを実行時に決めるマップでだけ使える
+    /// @param width [in] 幅
+    /// @param height [in] 高さ
+    void Resize(int width, int height)
+    {
+        static_assert((Width == HexMapDynamic) && (Height == HexMapDynamic), "only dynamic maps can be resized");
+        resize(width, height);
+    }
+
+    /// 全要素に値を設定する
+    /// @param value [in] 値
+    void Fill(const T& value) { std::fill(m_cells.begin(), m_cells.end(), value); }
+
+    /// チャンクの数取得
+    int GetChunkCount() const { return m_chunk_columns * m_chunk_rows; }
+
+    /// チャンク取得
+    /// @param index [in] チャンクの番号 左上から行順
+    Chunk      GetChunk(int index)       { return chunkOf<Chunk>(*this, index); }
+    ConstChunk GetChunk(int index) const { return chunkOf<ConstChunk>(*this, index); }
+
+    /// チャンクの先頭
+    ChunkIterator      ChunkBegin()       { return ChunkIterator(*this, 0); }
+    ConstChunkIterator ChunkBegin() const { return ConstChunkIterator(*this, 0); }
+    /// チャンクの終端
+    ChunkIterator      ChunkEnd()       { return ChunkIterator(*this, GetChunkCount()); }
+    ConstChunkIterator ChunkEnd() const { return ConstChunkIterator(*this, GetChunkCount()); }
+
+private:
+    /// 座標の下位ビットを一つおきに広げる
+    static int spread(int v)
+    {
+        v = (v | (v << 4)) & 0x0F0F;
+        v = (v | (v << 2)) & 0x3333;
+        v = (v | (v << 1)) & 0x5555;
+        return v;
+    }
+
+    /// 一つおきのビットを詰めて座標に戻す
+    static int compact(int v)
+    {
+        v &= 0x5555;
+        v = (v | (v >> 1)) & 0x3333;
+        v = (v | (v >> 2)) & 0x0F0F;
+        v = (v | (v >> 4)) & 0x00FF;
+        return v;
+    }
+
+    /// チャンク内の位置からモートン順の添字を取得
+    static int mortonOf(int x, int y) { return spread(x) | (spread(y) << 1); }
+
+    /// チャンクを取得
+    template <class ChunkType, class Map>
+    static ChunkType chunkOf(Map& map, int index)
+    {
+        const HexMapPosition origin((index % map.m_chunk_columns) * ChunkSize, (index / map.m_chunk_columns) * ChunkSize);
+        return ChunkType(origin,
+                         std::min(ChunkSize, map.m_width - origin.X()),
+                         std::min(ChunkSize, map.m_height - origin.Y()),
+                         &map.m_cells[index * ChunkCellCount]);
+    }
+
+    /// 大きさを変えて全要素を初期値にする
+    void resize(int width, int height)
+    {
+        assert((0 <= width) && (0 <= height));
+        m_width         = width;
+        m_height        = height;
+        m_chunk_columns = (width + ChunkSize - 1) >> ChunkShift;
+        m_chunk_rows    = (height + ChunkSize - 1) >> ChunkShift;
+        m_cells.assign(static_cast<std::size_t>(m_chunk_columns) * m_chunk_rows * ChunkCellCount, T());
+    }
+
+    int m_width;         /// 幅
+    int m_height;        /// 高さ
+    int m_chunk_columns; /// 横に並ぶチャンクの数
+    int m_chunk_rows;    /// 縦に並ぶチャンクの数
+
+    /// マップ要素 チャンクごとにChunkCellCount個ずつ並ぶ
+    std::vector<T> m_cells;
+};
+
+template <class T, int Width, int Height, int ChunkShift> const int HexTiledMap<T, Width, Height, ChunkShift>::ChunkSize;
+template <class T, int Width, int Height, int ChunkShift> const int HexTiledMap<T, Width, Height, ChunkShift>::ChunkCellCount;
+
+
+/// チャンク分割したマップのその位置に侵入可能であるか否かを判定する
+/// @param map [in] ヘックスマップ
+/// @param pos [in] 位置
+template <int Width, int Height, int ChunkShift>
+bool IsEntriable(const HexTiledMap<HexChip, Width, Height, ChunkShift>& map, const HexMapPosition& pos)
+{
+    if (pos.X() < 0) { return false; }
+    if (pos.Y() < 0) { return false; }
+    if (map.GetWidth() <= pos.X())  { return false; }
+    if (map.GetHeight() <= pos.Y()) { return false; }
+
+    return (map[pos] != HexChip::NoEntry);
+}
+
+/// チャンク分割したマップで, 複数の開始地点から経路マップと距離マップを生成する
+/// 侵入可否グリッドに写さず, モートン順の添字の上で幅優先探索する
+/// チャンク内の隣はGetNeighborBits()で添字から直接求め, チャンクの端を越えるときだけ位置から引き直す
+/// 距離マップの PathDistanceUnreachable を未訪問の印に使うので, 探索中は地形を読まない
+/// @tparam InputIterator HexMapPositionを指す入力イテレータ
+/// @param map [in] ヘックスマップ
+/// @param first [in] 開始地点の先頭
+/// @param last [in] 開始地点の終端
+/// @param path_map [out] 経路マップ 各位置の一つ手前の位置 開始地点と到達できない位置は自身を指す
+/// @param distance_map [out] 最寄りの開始地点からの距離マップ 到達できない位置はPathDistanceUnreachable 侵入不可の位置はPathDistanceNoEntry
+/// @param scratch [in,out] 作業領域 待ち行列だけを使い回す
+/// @retval 到達できた位置の数
+template <int Width, int Height, int ChunkShift, class InputIterator>
+int GeneratePathMap(const HexTiledMap<HexChip, Width, Height, ChunkShift>& map,
+                    InputIterator first,
+                    InputIterator last,
+                    HexTiledMap<HexMapPosition, Width, Height, ChunkShift>& path_map,
+                    HexTiledMap<int, Width, Height, ChunkShift>& distance_map,
+                    HexPathScratch& scratch)
+{
+    typedef HexTiledMap<int, Width, Height, ChunkShift> DistanceMap;
+    const int width  = map.GetWidth();
+    const int height = map.GetHeight();
+    assert((path_map.GetWidth() == width) && (path_map.GetHeight() == height));
+    assert((distance_map.GetWidth() == width) && (distance_map.GetHeight() == height));
+
+    /// チャンクごとに要素の並び順で初期化する マップの外にはみ出す要素は侵入不可にして番兵にする
+    for (int c(0); c < map.GetChunkCount(); ++c) {
+        const typename HexTiledMap<HexChip, Width, Height, ChunkShift>::ConstChunk chips = map.GetChunk(c);
+        HexMapPosition* path = path_map.GetChunk(c).GetCells();
+        int* distance        = distance_map.GetChunk(c).GetCells();
+        for (int k(0); k < DistanceMap::ChunkCellCount; ++k) {
+            const HexMapPosition pos = chips.PositionOf(k);
+            path[k]     = pos;
+            distance[k] = (chips.Contains(pos) && (chips.GetCells()[k] != HexChip::NoEntry))
+                        ? PathDistanceUnreachable : PathDistanceNoEntry;
+        }
+    }
+
+    /// 各位置は一度しか積まれないので, 配列をそのまま待ち行列として使う
+    std::vector<HexMapPosition>& frontier = scratch.frontier;
+    frontier.clear();
+    frontier.reserve(map.Size());
+
+    /// 開始地点設定
+    for (; first != last; ++first) {
+        const HexMapPosition start = *first;
+        if ((start.X() < 0) || (width <= start.X()))  { continue; }
+        if ((start.Y() < 0) || (height <= start.Y())) { continue; }
+        int& distance = distance_map.AtIndex(distance_map.IndexOf(start));
+        if (distance != PathDistanceUnreachable) { continue; }
+        distance = 0;
+        frontier.push_back(start);
+    }
+
+    for (std::size_t head(0); head < frontier.size(); ++head) {
+        const HexMapPosition pivot = frontier[head];
+        const int index   = distance_map.IndexOf(pivot);
+        const int next    = distance_map.AtIndex(index) + 1;
+        const int base    = index & ~(DistanceMap::ChunkCellCount - 1);
+        const int local_x = pivot.X() & (DistanceMap::ChunkSize - 1);
+        const int local_y = pivot.Y() & (DistanceMap::ChunkSize - 1);
+        const int* dx     = HexMapPosition::s_neighbor_x[pivot.Y() & 1];
+        const int* dy     = HexMapPosition::s_neighbor_y;
+        int columns[3];
+        int rows[3];
+        DistanceMap::GetNeighborBits(index, columns, rows);
+
+        for (int i(0); i < HexMapPosition::NeighborCount; ++i) {
+            const HexMapPosition candidate(pivot.X() + dx[i], pivot.Y() + dy[i]);
+            const unsigned int x = local_x + dx[i];
+            const unsigned int y = local_y + dy[i];
+            int candidate_index(0);
+            if ((x < static_cast<unsigned int>(DistanceMap::ChunkSize)) && (y < static_cast<unsigned int>(DistanceMap::ChunkSize))) {
+                candidate_index = base | columns[dx[i] + 1] | rows[dy[i] + 1];
+            } else {
+                // チャンクの端を越えるときだけ範囲を判定して引き直す
+                if ((candidate.X() < 0) || (width <= candidate.X()))  { continue; }
+                if ((candidate.Y() < 0) || (height <= candidate.Y())) { continue; }
+                candidate_index = distance_map.IndexOf(candidate);
+            }
+            int& distance = distance_map.AtIndex(candidate_index);
+            if (distance != PathDistanceUnreachable) { continue; }
+            distance = next;
+            path_map.AtIndex(candidate_index) = pivot;
+            frontier.push_back(candidate);
+        }
+    }
+    return static_cast<int>(frontier.size());
+}
+
+/// チャンク分割したマップで経路マップと距離マップを生成する
+/// @param map [in] ヘックスマップ
+/// @param start [in] 開始地点
+/// @param path_map [out] 経路マップ 各位置の一つ手前の位置 到達できない位置は自身を指す
+/// @param distance_map [out] 距離マップ 到達できない位置はPathDistanceUnreachable 侵入不可の位置はPathDistanceNoEntry
+/// @retval 到達できた位置の数
+template <int Width, int Height, int ChunkShift>
+int GeneratePathMap(const HexTiledMap<HexChip, Width, Height, ChunkShift>& map,
+                    const HexMapPosition& start,
+                    HexTiledMap<HexMapPosition, Width, Height, ChunkShift>& path_map,
+                    HexTiledMap<int, Width, Height, ChunkShift>& distance_map)
+{
+    HexPathScratch scratch;
+    return GeneratePathMap(map, &start, &start + 1, path_map, distance_map, scratch);
+}
+
+#endif
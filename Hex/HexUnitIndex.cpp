@@ -0,0 +1,130 @@
+//
+//  HexUnitIndex.cpp
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#include "HexUnitIndex.h"
+
+#include <algorithm>
+#include <cassert>
+
+const int HexUnitIndex::NoUnit;
+
+/// コンストラクタ
+HexUnitIndex::HexUnitIndex()
+:m_width(0)
+,m_height(0)
+,m_count(0)
+,m_free(NoUnit)
+{}
+
+/// コンストラクタ
+HexUnitIndex::HexUnitIndex(int width, int height)
+:m_width(0)
+,m_height(0)
+,m_count(0)
+,m_free(NoUnit)
+{
+    Resize(width, height);
+}
+
+/// 大きさ変更
+void HexUnitIndex::Resize(int width, int height)
+{
+    assert((0 <= width) && (0 <= height));
+    m_width  = width;
+    m_height = height;
+    m_head.assign(static_cast<std::size_t>(width) * height, NoUnit);
+    m_occupied.Resize(width, height);
+    m_units.clear();
+    m_count = 0;
+    m_free  = NoUnit;
+}
+
+/// 全ユニットを削除する
+void HexUnitIndex::Clear()
+{
+    std::fill(m_head.begin(), m_head.end(), NoUnit);
+    m_occupied.Clear();
+    m_units.clear();
+    m_count = 0;
+    m_free  = NoUnit;
+}
+
+/// ユニットを追加する
+int HexUnitIndex::Insert(const HexMapPosition& pos)
+{
+    assert(contains(pos));
+    int id = m_free;
+    if (id == NoUnit) {
+        id = static_cast<int>(m_units.size());
+        m_units.push_back(Unit());
+    } else {
+        m_free = m_units[id].next;
+    }
+    link(id, indexOf(pos));
+    ++m_count;
+    return id;
+}
+
+/// ユニットを削除する
+void HexUnitIndex::Remove(int id)
+{
+    assert(Contains(id));
+    unlink(id);
+    m_units[id].cell = -1;
+    m_units[id].next = m_free;
+    m_free = id;
+    --m_count;
+}
+
+/// ユニットを移動する
+void HexUnitIndex::Move(int id, const HexMapPosition& pos)
+{
+    assert(Contains(id) && contains(pos));
+    const int cell = indexOf(pos);
+    if (m_units[id].cell == cell) { return; }
+    unlink(id);
+    link(id, cell);
+}
+
+/// 線分上で最初にいるユニット取得
+int HexUnitIndex::FindFirstAlongLine(const HexMapPosition& a, const HexMapPosition& b) const
+{
+    HexLineCursor cursor(HexAxialPosition::FromOffset(a), HexAxialPosition::FromOffset(b));
+    for (cursor.Next(); cursor.IsValid(); cursor.Next()) {
+        const int id = GetFirst(cursor.Get());
+        if (id != NoUnit) { return id; }
+    }
+    return NoUnit;
+}
+
+/// ユニットを位置のリストに繋ぐ
+/// リストの先頭に入れる
+void HexUnitIndex::link(int id, int cell)
+{
+    Unit& unit = m_units[id];
+    unit.cell = cell;
+    unit.prev = NoUnit;
+    unit.next = m_head[cell];
+    if (unit.next != NoUnit) { m_units[unit.next].prev = id; }
+    m_head[cell] = id;
+    m_occupied.Set(positionOf(cell), true);
+}
+
+/// ユニットを位置のリストから外す
+/// 最後の一体ならば位置のビットを落とす
+void HexUnitIndex::unlink(int id)
+{
+    const Unit& unit = m_units[id];
+    if (unit.prev != NoUnit) {
+        m_units[unit.prev].next = unit.next;
+    } else {
+        m_head[unit.cell] = unit.next;
+    }
+    if (unit.next != NoUnit) { m_units[unit.next].prev = unit.prev; }
+    if (m_head[unit.cell] == NoUnit) { m_occupied.Set(positionOf(unit.cell), false); }
+}
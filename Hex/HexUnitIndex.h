@@ -0,0 +1,263 @@
+//
+//  HexUnitIndex.h
+//  Hex
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#ifndef Hex_HexUnitIndex_h
+#define Hex_HexUnitIndex_h
+
+#include "HexBitMap.h"
+#include "HexMap.h"
+#include "HexMapKernel.h"
+#include "HexRange.h"
+
+#include <vector>
+
+/// @class ユニットの位置の索引
+/// 位置ごとにそこにいるユニットの双方向リストの先頭を持ち, ユニットごとに位置とリストの前後を持つ
+/// 追加, 移動, 削除はリストを付け替えるだけなので定数時間で, 範囲の問い合わせは範囲内の位置を辿るだけで済む
+/// 削除したユニットの番号は空きリストに入れて使い回す
+/// ユニットのいる位置のビットを立てた層も持つので, 経路探索ではユニットのいる位置を侵入不可として扱える
+class HexUnitIndex
+{
+public:
+    /// ユニットがいないことを表す番号
+    static const int NoUnit = -1;
+
+    /// コンストラクタ
+    HexUnitIndex();
+
+    /// コンストラクタ
+    /// @param width [in] 幅
+    /// @param height [in] 高さ
+    HexUnitIndex(int width, int height);
+
+    /// 大きさ変更
+    /// 全ユニットを削除する
+    /// @param width [in] 幅
+    /// @param height [in] 高さ
+    void Resize(int width, int height);
+
+    /// 全ユニットを削除する
+    void Clear();
+
+    /// ユニットを追加する
+    /// @param pos [in] 位置 マップ内であること
+    /// @retval ユニットの番号
+    int Insert(const HexMapPosition& pos);
+
+    /// ユニットを削除する
+    /// @param id [in] ユニットの番号
+    void Remove(int id);
+
+    /// ユニットを移動する
+    /// @param id [in] ユニットの番号
+    /// @param pos [in] 移動先の位置 マップ内であること
+    void Move(int id, const HexMapPosition& pos);
+
+    /// ユニットが存在するか否か
+    /// @param id [in] ユニットの番号
+    bool Contains(int id) const
+    {
+        return (0 <= id) && (id < static_cast<int>(m_units.size())) && (0 <= m_units[id].cell);
+    }
+
+    /// ユニットの位置取得
+    /// @param id [in] ユニットの番号
+    HexMapPosition GetPosition(int id) const { return positionOf(m_units[id].cell); }
+
+    /// その位置の最初のユニット取得
+    /// GetNextと合わせて, その位置のユニットを辿る
+    /// @param pos [in] 位置
+    /// @retval ユニットの番号 いなければNoUnit
+    int GetFirst(const HexMapPosition& pos) const { return contains(pos) ? m_head[indexOf(pos)] : NoUnit; }
+
+    /// 同じ位置の次のユニット取得
+    /// @param id [in] ユニットの番号
+    /// @retval ユニットの番号 いなければNoUnit
+    int GetNext(int id) const { return m_units[id].next; }
+
+    /// その位置にユニットがいるか否か
+    /// @param pos [in] 位置 マップ外ならばfalse
+    bool IsOccupied(const HexMapPosition& pos) const { return contains(pos) && m_occupied[pos]; }
+
+    /// ユニットのいる位置のビットが立った層取得
+    const HexBitMap& GetOccupancy() const { return m_occupied; }
+
+    /// 範囲内のユニットを辿る
+    /// @tparam Function ユニットの番号を受け取る関数
+    /// @param center [in] 中心
+    /// @param radius [in] 半径
+    /// @param f [in] 関数
+    /// @retval 辿ったユニットの数
+    template <class Function>
+    int ForEachInRange(const HexMapPosition& center, int radius, Function f) const
+    {
+        int count(0);
+        const HexPositionRange<HexFilledCursor> range = HexFilledRange(center, radius, *this);
+        for (HexPositionRange<HexFilledCursor>::iterator it = range.begin(); it != range.end(); ++it) {
+            if (! m_occupied[*it]) { continue; }
+            for (int id = m_head[indexOf(*it)]; id != NoUnit; id = m_units[id].next) {
+                f(id);
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    /// 範囲内のユニットを集める
+    /// @param center [in] 中心
+    /// @param radius [in] 半径
+    /// @param ids [out] ユニットの番号を末尾に追加する
+    /// @retval 追加したユニットの数
+    int CollectInRange(const HexMapPosition& center, int radius, std::vector<int>& ids) const
+    {
+        return ForEachInRange(center, radius, Collector(ids));
+    }
+
+    /// 範囲内のユニットの数取得
+    /// @param center [in] 中心
+    /// @param radius [in] 半径
+    int CountInRange(const HexMapPosition& center, int radius) const
+    {
+        return ForEachInRange(center, radius, Counter());
+    }
+
+    /// 線分上で最初にいるユニット取得
+    /// 始点の次の位置から終点までを始点に近い順に調べる 始点にいるユニットは数えない
+    /// 同じ位置に複数いれば, その位置の最初のユニットを返す
+    /// @param a [in] 始点
+    /// @param b [in] 終点
+    /// @retval ユニットの番号 いなければNoUnit
+    int FindFirstAlongLine(const HexMapPosition& a, const HexMapPosition& b) const;
+
+    /// 全ユニットを辿る
+    /// @tparam Function ユニットの番号を受け取る関数
+    /// @param f [in] 関数
+    template <class Function>
+    void ForEach(Function f) const
+    {
+        for (int id(0); id < static_cast<int>(m_units.size()); ++id) {
+            if (0 <= m_units[id].cell) { f(id); }
+        }
+    }
+
+    /// ユニット数取得
+    int GetUnitCount() const { return m_count; }
+    /// 幅取得
+    int GetWidth() const { return m_width; }
+    /// 高さ取得
+    int GetHeight() const { return m_height; }
+
+private:
+    /// ユニット
+    struct Unit
+    {
+        int cell; /// 位置の添字 削除済みならば-1
+        int next; /// 同じ位置の次のユニット 削除済みならば空きリストの次
+        int prev; /// 同じ位置の前のユニット
+    };
+
+    /// ユニットの番号を集める
+    struct Collector
+    {
+        explicit Collector(std::vector<int>& ids) :m_ids(ids) {}
+        void operator()(int id) const { m_ids.push_back(id); }
+        std::vector<int>& m_ids;
+    };
+
+    /// 何もしない 数えるだけに使う
+    struct Counter
+    {
+        void operator()(int) const {}
+    };
+
+    /// ユニットを位置のリストに繋ぐ
+    void link(int id, int cell);
+    /// ユニットを位置のリストから外す
+    void unlink(int id);
+
+    /// マップ内であるか否か
+    bool contains(const HexMapPosition& pos) const
+    {
+        return (0 <= pos.X()) && (0 <= pos.Y()) && (pos.X() < m_width) && (pos.Y() < m_height);
+    }
+
+    /// 位置から添字を取得
+    int indexOf(const HexMapPosition& pos) const { return pos.X() + m_width * pos.Y(); }
+    /// 添字から位置を取得
+    HexMapPosition positionOf(int index) const { return HexMapPosition(index % m_width, index / m_width); }
+
+    int m_width;  /// 幅
+    int m_height; /// 高さ
+    int m_count;  /// ユニット数
+    int m_free;   /// 空きリストの先頭
+
+    std::vector<int>  m_head;     /// 位置ごとの最初のユニット
+    std::vector<Unit> m_units;    /// ユニットごとの位置とリスト
+    HexBitMap         m_occupied; /// ユニットのいる位置
+};
+
+/// マップのその位置に侵入可能で, ユニットがいないか否かを判定する
+/// @param map [in] ヘックスマップ
+/// @param units [in] ユニットの位置の索引 マップと同じ大きさ
+/// @param pos [in] 位置
+template <int Width, int Height>
+bool IsEntriable(const HexMap<HexChip, Width, Height>& map, const HexUnitIndex& units, const HexMapPosition& pos)
+{
+    return IsEntriable(map, pos) && (! units.IsOccupied(pos));
+}
+
+/// ヘックスマップとユニットの位置から侵入可否の層を作る
+/// 地形の層からユニットのいる位置のビットを語単位で落とす
+/// 動かすユニット自身の位置など, 開けておきたい位置は呼び出し側でビットを立て直すこと
+/// @param map [in] ヘックスマップ
+/// @param units [in] ユニットの位置の索引 マップと同じ大きさ
+/// @param passable [out] 侵入可能でユニットのいない位置のビットが立った層
+template <int Width, int Height>
+void BuildPassableBitMap(const HexMap<HexChip, Width, Height>& map, const HexUnitIndex& units, HexBitMap& passable)
+{
+    assert((map.GetWidth() == units.GetWidth()) && (map.GetHeight() == units.GetHeight()));
+    BuildPassableBitMap(map, passable);
+
+    const HexBitMap& occupied = units.GetOccupancy();
+    for (int j(0); j < passable.GetHeight(); ++j) {
+        uint64_t* row        = passable.GetRow(j);
+        const uint64_t* mask = occupied.GetRow(j);
+        for (int w(0); w < passable.GetWordCount(); ++w) { row[w] &= ~mask[w]; }
+    }
+}
+
+/// ユニットのいる位置を侵入不可として, 経路マップと距離マップを生成する
+/// 地形からグリッドを構築し, 各ユニットの位置を閉じてから幅優先探索する
+/// 開始地点は自身がいても開けておく ユニットのいる位置の距離はPathDistanceNoEntryになる
+/// @param map [in] ヘックスマップ
+/// @param units [in] ユニットの位置の索引 マップと同じ大きさ
+/// @param start [in] 開始地点
+/// @param path_map [out] 経路マップ 各位置の一つ手前の位置 到達できない位置は自身を指す
+/// @param distance_map [out] 距離マップ 到達できない位置はPathDistanceUnreachable 侵入不可の位置はPathDistanceNoEntry
+/// @param scratch [in,out] 作業領域 確保済みの領域を使い回す
+/// @retval 到達できた位置の数
+template <int Width, int Height>
+int GeneratePathMap(const HexMap<HexChip, Width, Height>& map,
+                    const HexUnitIndex& units,
+                    const HexMapPosition& start,
+                    HexMap<HexMapPosition, Width, Height>& path_map,
+                    HexMap<int, Width, Height>& distance_map,
+                    HexPathScratch& scratch)
+{
+    assert((map.GetWidth() == units.GetWidth()) && (map.GetHeight() == units.GetHeight()));
+    HexPassableGrid& grid = scratch.grid;
+    grid.Build(map);
+
+    units.ForEach([&](int id) {
+        const HexMapPosition pos = units.GetPosition(id);
+        if (pos != start) { grid.Close(grid.IndexOf(pos)); }
+    });
+    return GeneratePathMapOnGrid(&start, &start + 1, path_map, distance_map, scratch);
+}
+
+#endif
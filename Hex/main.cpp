@@ -23,7 +23,9 @@
 
 #include "HexChip.h"
 #include "HexMapPosition.h"
+#include "HexAxialPosition.h"
 #include "HexMap.h"
+#include "HexPathRepair.h"
 
 HexMapPosition::Neighbor GetNeighbor(char c)
 {
@@ -299,13 +301,17 @@ struct Translation
 
 Translation GetTranslationFromHexMapPosition(const HexMapPosition& pos)
 {
-    return Translation(2*pos.X() + ((pos.Y() % 2 == 1) ? 1 : 0), -2*pos.Y(), 0);
+    const HexAxialPosition axial = HexAxialPosition::FromOffset(pos);
+    return Translation(2*axial.Q() + axial.R(), -2*axial.R(), 0);
 }
 
 static const HexPrimitive::Color s_hex_colors[HexChip::Count] =
 {
     HexPrimitive::Color(1.0f, 1.0f, 1.0f),
     HexPrimitive::Color(0.5f, 0.5f, 0.5f),
+    HexPrimitive::Color(0.8f, 0.7f, 0.5f),
+    HexPrimitive::Color(0.2f, 0.6f, 0.2f),
+    HexPrimitive::Color(0.4f, 0.4f, 0.3f),
 };
 
 
@@ -620,29 +626,29 @@ int main(int argc, char* argv[])
 {
     hex_map[HexMapPosition(2,3)] = HexChip::NoEntry;
 #if 0
-    const HexMap<HexMapPosition, 5, 5> path_map = GeneratePathMap(hex_map, pos);
-    
+    HexMap<HexMapPosition, 5, 5> path_map;
     HexMap<int, 5, 5> distance_map;
-    std::transform(HexMapPositionIterator<5,5>::begin()
-                   ,HexMapPositionIterator<5,5>::end()
-                   ,distance_map.begin()
-                   ,CalcDistance<5, 5>(path_map, pos)
-                   );
+    GeneratePathMap(hex_map, pos, path_map, distance_map);
     
     std::cout << distance_map <<std::endl;
     
+    HexPathRepairer<5, 5> repairer;
     char c;		
     while (std::cin >> c) {
         const HexMapPosition::Neighbor neighbor = GetNeighbor(c);
+        const HexMapPosition prev = pos;
         hex_map[pos].SetType(HexChip::Standard);
         if (IsEntriable(hex_map, pos.GetNeighbor(neighbor))) {
             pos = pos.GetNeighbor(neighbor);
         }
         hex_map.At(pos).SetType(HexChip::NoEntry);
         
+        const HexMapPosition changed[] = { prev, pos };
+        repairer.Repair(hex_map, changed, changed + 2, path_map, distance_map);
         
         std::cout << neighbor << std::endl;
         std::cout << hex_map << std::endl;
+        std::cout << distance_map << std::endl;
         std::cout << "cursor: " << pos << std::endl;
     }
 #endif
@@ -0,0 +1,46 @@
+//
+//  HexAllocCounter.cpp
+//  HexBench
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#include "HexAllocCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+
+std::atomic<long long> s_count(0); /// 確保の回数
+std::atomic<long long> s_bytes(0); /// 確保したバイト数
+
+/// 数えてから確保する
+void* countedAlloc(std::size_t size)
+{
+    s_count.fetch_add(1, std::memory_order_relaxed);
+    s_bytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+    void* p = std::malloc((size == 0) ? 1 : size);
+    if (p == NULL) { throw std::bad_alloc(); }
+    return p;
+}
+
+}
+
+/// これまでのメモリ確保の回数と量を取得
+HexAllocStats GetHexAllocStats()
+{
+    HexAllocStats stats;
+    stats.count = s_count.load(std::memory_order_relaxed);
+    stats.bytes = s_bytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+// 置き換えたoperator new 例外を投げない版は標準ライブラリがこちらを呼ぶ
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
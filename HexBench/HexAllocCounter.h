@@ -0,0 +1,25 @@
+//
+//  HexAllocCounter.h
+//  HexBench
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+
+#ifndef HexBench_HexAllocCounter_h
+#define HexBench_HexAllocCounter_h
+
+#include <cstddef>
+
+/// メモリ確保の回数と量
+/// ベンチマークのプログラム全体でoperator newを置き換えて数える
+struct HexAllocStats
+{
+    long long count; /// 確保の回数
+    long long bytes; /// 確保したバイト数
+};
+
+/// これまでのメモリ確保の回数と量を取得
+HexAllocStats GetHexAllocStats();
+
+#endif
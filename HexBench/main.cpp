@@ -0,0 +1,809 @@
+//
+//  main.cpp
+//  HexBench
+//
+//  Created by akisubal on 2026/10/17.
+//  Copyright (c) 2026年 akisubal. All rights reserved.
+//
+//  経路, 隣接, マップ走査の処理の速さとメモリ確保の回数を測る
+//  --verifyか--quickのときは, 測る前に各探索の結果を基準の探索と突き合わせ, 食い違えば0以外で終わる
+//  使い方: hex_bench [--quick] [--verify] [--min-time ミリ秒] [--filter 部分文字列]
+//
+
+#include "HexAllocCounter.h"
+
+#include "HexAxialPosition.h"
+#include "HexChip.h"
+#include "HexComponentMap.h"
+#include "HexDistanceOracle.h"
+#include "HexMap.h"
+#include "HexMapPosition.h"
+#include "HexMoveCost.h"
+#include "HexPathHierarchy.h"
+#include "HexPathParallel.h"
+#include "HexPathRepair.h"
+#include "HexSearchContext.h"
+#include "HexTiledMap.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+
+typedef HexMap<HexChip, HexMapDynamic, HexMapDynamic>        ChipMap;
+typedef HexMap<HexMapPosition, HexMapDynamic, HexMapDynamic> PositionMap;
+typedef HexMap<int, HexMapDynamic, HexMapDynamic>            DistanceMap;
+typedef HexMapPositionIterator<HexMapDynamic, HexMapDynamic> PositionIterator;
+typedef HexTiledMap<HexChip, HexMapDynamic, HexMapDynamic>        TiledChipMap;
+typedef HexTiledMap<HexMapPosition, HexMapDynamic, HexMapDynamic> TiledPositionMap;
+typedef HexTiledMap<int, HexMapDynamic, HexMapDynamic>            TiledDistanceMap;
+
+/// 最適化で処理が消えないように結果を書き込む先
+volatile long long s_sink(0);
+
+/// 再現できる乱数 (xorshift)
+class Random
+{
+public:
+    explicit Random(unsigned int seed) :m_state(seed * 2654435761u + 1) {}
+
+    /// [0, n)の整数
+    int Next(int n)
+    {
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 17;
+        m_state ^= m_state << 5;
+        return static_cast<int>(m_state % static_cast<unsigned int>(n));
+    }
+
+private:
+    unsigned int m_state;
+};
+
+
+/// 地形の種類
+enum Terrain
+{
+    TerrainOpen = 0, /// 障害物が少ない平原
+    TerrainMaze,     /// 一本道の迷路
+    TerrainIslands,  /// 侵入不可の海に浮かぶ島
+    TerrainCount
+};
+
+/// 地形の名前
+const char* const s_terrain_names[TerrainCount] = { "open", "maze", "islands" };
+
+/// 平原を作る
+/// 森, 沼, 道を混ぜ, 2%を侵入不可にする
+void BuildOpen(ChipMap& map, Random& random)
+{
+    static const HexChip::Type types[] = { HexChip::Standard, HexChip::Road, HexChip::Forest, HexChip::Swamp };
+    for (PositionIterator it = PositionIterator::begin(map.GetWidth(), map.GetHeight()); it != PositionIterator::end(map.GetWidth(), map.GetHeight()); ++it) {
+        const int roll = random.Next(100);
+        map[*it] = (roll < 2) ? HexChip::NoEntry : types[roll % 4];
+    }
+}
+
+/// 迷路を作る
+/// 偶数の行と列の位置を部屋とし, 深さ優先で間の位置を掘る
+/// 奇数行の(x, y)は左下が(x, y+1)に, 偶数行の(x, y)は右下が(x, y+1)に接するので縦にも掘れる
+void BuildMaze(ChipMap& map, Random& random)
+{
+    std::fill(map.begin(), map.end(), HexChip(HexChip::NoEntry));
+    const int rooms_x = (map.GetWidth() + 1) / 2;
+    const int rooms_y = (map.GetHeight() + 1) / 2;
+    std::vector<char> visited(rooms_x * rooms_y, 0);
+    std::vector<int> stack(1, 0);
+    visited[0] = 1;
+    map[HexMapPosition(0, 0)] = HexChip::Standard;
+
+    static const int dx[] = { 1, 0, -1, 0 };
+    static const int dy[] = { 0, 1, 0, -1 };
+    while (! stack.empty()) {
+        const int room = stack.back();
+        const int rx = room % rooms_x;
+        const int ry = room / rooms_x;
+
+        int candidates[4];
+        int count(0);
+        for (int i(0); i < 4; ++i) {
+            const int nx = rx + dx[i];
+            const int ny = ry + dy[i];
+            if ((nx < 0) || (ny < 0) || (rooms_x <= nx) || (rooms_y <= ny)) { continue; }
+            if (visited[nx + rooms_x * ny]) { continue; }
+            candidates[count++] = i;
+        }
+        if (count == 0) {
+            stack.pop_back();
+            continue;
+        }
+
+        const int d = candidates[random.Next(count)];
+        const int nx = rx + dx[d];
+        const int ny = ry + dy[d];
+        map[HexMapPosition(rx * 2 + dx[d], ry * 2 + dy[d])] = HexChip::Standard;
+        map[HexMapPosition(nx * 2, ny * 2)] = HexChip::Standard;
+        visited[nx + rooms_x * ny] = 1;
+        stack.push_back(nx + rooms_x * ny);
+    }
+}
+
+/// 島を作る
+/// 海を侵入不可とし, 矩形の島をばらまいて四割ほどを陸にする
+void BuildIslands(ChipMap& map, Random& random)
+{
+    std::fill(map.begin(), map.end(), HexChip(HexChip::NoEntry));
+    const int width  = map.GetWidth();
+    const int height = map.GetHeight();
+    const int max_size = std::max(2, std::min(width, height) / 8);
+    int land(0);
+    while (land * 10 < map.Size() * 4) {
+        const int w = 1 + random.Next(max_size);
+        const int h = 1 + random.Next(max_size);
+        const int x0 = random.Next(width);
+        const int y0 = random.Next(height);
+        for (int y = y0; (y < y0 + h) && (y < height); ++y) {
+            for (int x = x0; (x < x0 + w) && (x < width); ++x) {
+                HexChip& chip = map[HexMapPosition(x, y)];
+                if (chip == HexChip::NoEntry) { ++land; }
+                chip = (random.Next(4) == 0) ? HexChip::Forest : HexChip::Standard;
+            }
+        }
+    }
+}
+
+/// 地形を作る
+void BuildTerrain(Terrain terrain, ChipMap& map, unsigned int seed)
+{
+    Random random(seed);
+    switch (terrain) {
+        case TerrainOpen:    BuildOpen(map, random);    break;
+        case TerrainMaze:    BuildMaze(map, random);    break;
+        case TerrainIslands: BuildIslands(map, random); break;
+        default: break;
+    }
+}
+
+/// 開始地点を選ぶ
+/// 最も大きい連結成分のうち中央から近い位置 小さな島から始めて経路が短くならないようにする
+/// 迷路は全体が一つの連結成分なので, 部屋のある偶数の位置になる
+HexMapPosition ChooseStart(const ChipMap& map)
+{
+    HexComponentMap components;
+    components.Build(map);
+
+    std::unordered_map<int, int> sizes;
+    int largest(HexComponentMap::NoComponent);
+    for (PositionIterator it = PositionIterator::begin(map.GetWidth(), map.GetHeight()); it != PositionIterator::end(map.GetWidth(), map.GetHeight()); ++it) {
+        const int component = components.GetComponent(*it);
+        if (component == HexComponentMap::NoComponent) { continue; }
+        const int size = ++sizes[component];
+        if ((largest == HexComponentMap::NoComponent) || (sizes[largest] < size)) { largest = component; }
+    }
+
+    const HexMapPosition center((map.GetWidth() / 2) & ~1, (map.GetHeight() / 2) & ~1);
+    for (int r(0); r < map.GetWidth() + map.GetHeight(); ++r) {
+        for (int y = center.Y() - r; y <= center.Y() + r; ++y) {
+            for (int x = center.X() - r; x <= center.X() + r; ++x) {
+                const HexMapPosition pos(x, y);
+                if ((largest != HexComponentMap::NoComponent) && (components.GetComponent(pos) == largest)) { return pos; }
+            }
+        }
+    }
+    return center;
+}
+
+
+/// 計測の設定
+struct Options
+{
+    std::vector<int> sizes; /// マップの一辺
+    double min_time;        /// 一つの計測にかける最小の秒数
+    std::string filter;     /// 処理名に含む文字列 空ならばすべて
+    bool verify;            /// 測る前に結果を突き合わせるか否か
+};
+
+/// 計測対象の処理が使う入力
+struct Fixture
+{
+    ChipMap map;                         /// 地形
+    HexMapPosition start;                /// 開始地点
+    PositionMap path_map;                /// 開始地点からの経路マップ
+    DistanceMap distance_map;            /// 開始地点からの距離マップ
+    std::vector<HexMapPosition> targets; /// 到達できる位置から選んだ終点
+    long long target_steps;              /// 全終点までの経路の長さの合計
+    HexPathScratch scratch;              /// 経路マップ生成の作業領域
+    TiledChipMap tiled_map;              /// チャンク分割した同じ地形
+    TiledPositionMap tiled_path_map;     /// チャンク分割した経路マップ
+    TiledDistanceMap tiled_distance_map; /// チャンク分割した距離マップ
+};
+
+/// 計測対象の処理
+/// 一回分を実行し, 処理した要素の数を返す
+typedef long long (*Kernel)(Fixture& fixture);
+
+/// 経路マップ生成 作業領域と出力を使い回す
+long long KernelGeneratePathMap(Fixture& f)
+{
+    s_sink += GeneratePathMap(f.map, &f.start, &f.start + 1, f.path_map, f.distance_map, f.scratch);
+    return f.map.Size();
+}
+
+/// 経路マップ生成 戻り値で受け取り毎回確保する
+long long KernelGeneratePathMapByValue(Fixture& f)
+{
+    const PositionMap path_map = GeneratePathMap(f.map, f.start);
+    s_sink += path_map[f.start].X();
+    return f.map.Size();
+}
+
+/// チャンク分割したマップで経路マップ生成 作業領域と出力を使い回す
+long long KernelGeneratePathMapTiled(Fixture& f)
+{
+    s_sink += GeneratePathMap(f.tiled_map, &f.start, &f.start + 1, f.tiled_path_map, f.tiled_distance_map, f.scratch);
+    return f.map.Size();
+}
+
+/// 経路マップを辿って長さを数える
+long long KernelCalcPathLength(Fixture& f)
+{
+    long long total(0);
+    for (std::size_t i(0); i < f.targets.size(); ++i) {
+        total += CalcPathLength(f.path_map, f.start, f.targets[i]);
+    }
+    s_sink += total;
+    return f.target_steps;
+}
+
+/// 距離の関数オブジェクトで終点の距離をまとめて求める
+long long KernelCalcDistance(Fixture& f)
+{
+    static std::vector<int> distances;
+    distances.resize(f.targets.size());
+    std::transform(f.targets.begin(), f.targets.end(), distances.begin(),
+                   CalcDistance<HexMapDynamic, HexMapDynamic>(f.path_map, f.start));
+    s_sink += distances.empty() ? 0 : distances.back();
+    return f.target_steps;
+}
+
+/// 全位置の6方向の隣を求める
+long long KernelGetNeighbor(Fixture& f)
+{
+    long long total(0);
+    for (int y(0); y < f.map.GetHeight(); ++y) {
+        for (int x(0); x < f.map.GetWidth(); ++x) {
+            const HexMapPosition pos(x, y);
+            for (int i(0); i < HexMapPosition::NeighborCount; ++i) {
+                const HexMapPosition neighbor = pos.GetNeighbor(static_cast<HexMapPosition::Neighbor>(i));
+                total += neighbor.X() ^ neighbor.Y();
+            }
+        }
+    }
+    s_sink += total;
+    return static_cast<long long>(f.map.Size()) * HexMapPosition::NeighborCount;
+}
+
+/// 全位置の6方向の隣の侵入可否を判定する マップ外も含む
+long long KernelIsEntriable(Fixture& f)
+{
+    long long total(0);
+    for (int y(0); y < f.map.GetHeight(); ++y) {
+        for (int x(0); x < f.map.GetWidth(); ++x) {
+            const HexMapPosition pos(x, y);
+            for (int i(0); i < HexMapPosition::NeighborCount; ++i) {
+                if (IsEntriable(f.map, pos.GetNeighbor(static_cast<HexMapPosition::Neighbor>(i)))) { ++total; }
+            }
+        }
+    }
+    s_sink += total;
+    return static_cast<long long>(f.map.Size()) * HexMapPosition::NeighborCount;
+}
+
+/// 位置のイテレータで全位置を辿る
+long long KernelIterator(Fixture& f)
+{
+    long long total(0);
+    const PositionIterator last = PositionIterator::end(f.map.GetWidth(), f.map.GetHeight());
+    for (PositionIterator it = PositionIterator::begin(f.map.GetWidth(), f.map.GetHeight()); it != last; ++it) {
+        total += f.map[*it].GetType();
+    }
+    s_sink += total;
+    return f.map.Size();
+}
+
+/// テキストに書き出す
+long long KernelWriteText(Fixture& f)
+{
+    std::ostringstream os;
+    os << f.map;
+    s_sink += static_cast<long long>(os.tellp());
+    return f.map.Size();
+}
+
+/// 計測対象の処理の一覧
+struct KernelEntry
+{
+    const char* name; /// 処理名
+    const char* unit; /// 数える要素
+    Kernel kernel;    /// 処理
+};
+
+const KernelEntry s_kernels[] = {
+    { "GeneratePathMap",         "cells",     KernelGeneratePathMap },
+    { "GeneratePathMap(value)",  "cells",     KernelGeneratePathMapByValue },
+    { "GeneratePathMap(tiled)",  "cells",     KernelGeneratePathMapTiled },
+    { "CalcPathLength",          "steps",     KernelCalcPathLength },
+    { "CalcDistance",            "steps",     KernelCalcDistance },
+    { "GetNeighbor",             "neighbors", KernelGetNeighbor },
+    { "IsEntriable",             "neighbors", KernelIsEntriable },
+    { "HexMapPositionIterator",  "cells",     KernelIterator },
+    { "operator<<",              "cells",     KernelWriteText },
+};
+
+/// 突き合わせに使う移動コスト表
+const HexMoveCost s_check_cost;
+/// 地形を変えて突き合わせる回数
+const int s_check_rounds = 8;
+/// 一回に地形を変える位置の数
+const int s_check_changes = 8;
+/// 二点間の探索を突き合わせる回数
+const int s_check_queries = 64;
+/// 階層的経路探索のコストの合計が最短の合計を超えてよい割合 (百分率)
+const int s_max_hierarchy_excess = 25;
+
+/// 食い違いを表示する
+/// @retval 常にfalse
+bool ReportMismatch(const char* what, const HexMapPosition& pos, int expected, int actual)
+{
+    std::fprintf(stderr, "  %s at (%d, %d): expected %d, got %d\n", what, pos.X(), pos.Y(), expected, actual);
+    return false;
+}
+
+/// 距離マップを全位置で突き合わせる
+/// 到達できない位置と侵入不可の位置も区別する
+template <class Expected, class Actual>
+bool SameDistances(const char* what, const Expected& expected, const Actual& actual)
+{
+    const int width  = expected.GetWidth();
+    const int height = expected.GetHeight();
+    for (PositionIterator it = PositionIterator::begin(width, height); it != PositionIterator::end(width, height); ++it) {
+        if (expected[*it] != actual[*it]) { return ReportMismatch(what, *it, expected[*it], actual[*it]); }
+    }
+    return true;
+}
+
+/// 経路マップが距離マップと矛盾しないか確かめる
+/// 到達した位置の一つ手前は隣にあり, その距離に移動コストを足すとその位置の距離になる
+template <class Chips, class Paths, class Distances>
+bool ConsistentParents(const char* what, const Chips& map, const HexMoveCost& cost, const Paths& path_map, const Distances& distance_map)
+{
+    const int width  = map.GetWidth();
+    const int height = map.GetHeight();
+    for (PositionIterator it = PositionIterator::begin(width, height); it != PositionIterator::end(width, height); ++it) {
+        const int distance = distance_map[*it];
+        if (distance <= 0) { continue; }
+        const HexMapPosition parent = path_map[*it];
+        const int expected = (HexDistance(parent, *it) == 1) ? distance_map[parent] + cost(map[*it]) : PathDistanceUnreachable;
+        if (expected != distance) { return ReportMismatch(what, *it, distance, expected); }
+    }
+    return true;
+}
+
+/// 開始地点以外の位置の地形を変える
+/// 侵入可能な位置は大半を塞ぎ, 残りは別の地形にする 侵入不可の位置は開く
+/// @param changed [out] 変えた位置
+void MutateTerrain(ChipMap& map, const HexMapPosition& keep, Random& random, std::vector<HexMapPosition>& changed)
+{
+    static const HexChip::Type types[] = { HexChip::Standard, HexChip::Road, HexChip::Forest, HexChip::Swamp };
+    changed.clear();
+    while (static_cast<int>(changed.size()) < s_check_changes) {
+        const HexMapPosition pos(random.Next(map.GetWidth()), random.Next(map.GetHeight()));
+        if (pos == keep) { continue; }
+        HexChip& chip = map[pos];
+        if (chip == HexChip::NoEntry) {
+            chip = types[random.Next(4)];
+        } else {
+            chip = (random.Next(4) != 0) ? HexChip::NoEntry : types[random.Next(4)];
+        }
+        changed.push_back(pos);
+    }
+}
+
+/// 二点間の探索の目標地点を選ぶ
+/// 偶数回目は到達できる終点, 奇数回目はマップ全体から選び, 到達できない位置や侵入不可の位置も含める
+HexMapPosition ChooseGoal(const Fixture& f, Random& random, int query)
+{
+    if ((query % 2 == 0) && (! f.targets.empty())) { return f.targets[random.Next(static_cast<int>(f.targets.size()))]; }
+    return HexMapPosition(random.Next(f.map.GetWidth()), random.Next(f.map.GetHeight()));
+}
+
+/// 基準のコストマップから二点間のコストを取得
+/// @retval コスト 到達できなければPathDistanceUnreachable
+int ExpectedCost(const DistanceMap& distance_map, const HexMapPosition& goal)
+{
+    return (distance_map[goal] < 0) ? static_cast<int>(PathDistanceUnreachable) : distance_map[goal];
+}
+
+/// 突き合わせの処理
+/// 基準の探索と結果を比べ, 食い違いを表示してfalseを返す
+typedef bool (*Check)(const Fixture& fixture);
+
+/// チャンク分割したマップの幅優先探索を平らなマップと突き合わせる
+bool CheckTiled(const Fixture& f)
+{
+    const int size = f.map.GetWidth();
+    TiledPositionMap path_map(size, size);
+    TiledDistanceMap distance_map(size, size);
+    HexPathScratch scratch;
+    GeneratePathMap(f.tiled_map, &f.start, &f.start + 1, path_map, distance_map, scratch);
+    return SameDistances("distance", f.distance_map, distance_map)
+        && ConsistentParents("parent", f.tiled_map, HexMoveCost::Uniform(), path_map, distance_map);
+}
+
+/// 並列の幅優先探索と並列の二点間探索を逐次の探索と突き合わせる
+/// 作業領域の世代の使い回しも確かめるため, 同じ作業領域で二度探索する
+bool CheckParallel(const Fixture& f)
+{
+    const int size = f.map.GetWidth();
+    HexPathExecutor executor(4);
+    HexParallelPathScratch scratch;
+    PositionMap path_map(size, size);
+    DistanceMap distance_map(size, size);
+    for (int run(0); run < 2; ++run) {
+        GeneratePathMapParallel(executor, f.map, f.start, path_map, distance_map, scratch);
+        if (! SameDistances("distance", f.distance_map, distance_map)) { return false; }
+        if (! ConsistentParents("parent", f.map, HexMoveCost::Uniform(), path_map, distance_map)) { return false; }
+    }
+
+    PositionMap expected_path(size, size);
+    DistanceMap expected(size, size);
+    GenerateCostMap(f.map, s_check_cost, f.start, expected_path, expected);
+
+    Random random(static_cast<unsigned int>(size));
+    std::vector<HexMapPosition> starts(s_check_queries, f.start);
+    std::vector<HexMapPosition> goals(s_check_queries);
+    std::vector<int> distances(s_check_queries);
+    for (int q(0); q < s_check_queries; ++q) { goals[q] = ChooseGoal(f, random, q); }
+    HexPathQueryRunner<HexMapDynamic, HexMapDynamic> runner;
+    runner.FindPaths(executor, f.map, s_check_cost, &starts[0], &goals[0], s_check_queries, &distances[0]);
+    for (int q(0); q < s_check_queries; ++q) {
+        const int cost = ExpectedCost(expected, goals[q]);
+        if (distances[q] != cost) { return ReportMismatch("query cost", goals[q], cost, distances[q]); }
+    }
+    return true;
+}
+
+/// 地形を変えては経路マップを部分修復し, 作り直したものと突き合わせる
+/// 歩数の経路マップと移動コストを考慮した経路マップの両方を修復する
+bool CheckRepair(const Fixture& f)
+{
+    const int size = f.map.GetWidth();
+    ChipMap map(f.map);
+    PositionMap path_map(f.path_map);
+    DistanceMap distance_map(f.distance_map);
+    PositionMap cost_path_map(size, size);
+    DistanceMap cost_map(size, size);
+    GenerateCostMap(map, s_check_cost, f.start, cost_path_map, cost_map);
+
+    PositionMap expected_path(size, size);
+    DistanceMap expected(size, size);
+    HexPathRepairer<HexMapDynamic, HexMapDynamic> repairer;
+    std::vector<HexMapPosition> changed;
+    Random random(static_cast<unsigned int>(size) + 1);
+    for (int round(0); round < s_check_rounds; ++round) {
+        MutateTerrain(map, f.start, random, changed);
+
+        repairer.Repair(map, changed.begin(), changed.end(), path_map, distance_map);
+        GeneratePathMap(map, f.start, expected_path, expected);
+        if (! SameDistances("distance", expected, distance_map)) { return false; }
+        if (! ConsistentParents("parent", map, HexMoveCost::Uniform(), path_map, distance_map)) { return false; }
+
+        repairer.Repair(map, s_check_cost, changed.begin(), changed.end(), cost_path_map, cost_map);
+        GenerateCostMap(map, s_check_cost, f.start, expected_path, expected);
+        if (! SameDistances("cost", expected, cost_map)) { return false; }
+        if (! ConsistentParents("cost parent", map, s_check_cost, cost_path_map, cost_map)) { return false; }
+    }
+    return true;
+}
+
+/// ランドマークの事前計算表の問い合わせと上下界をダイクストラ法と突き合わせる
+bool CheckOracle(const Fixture& f)
+{
+    const int size = f.map.GetWidth();
+    PositionMap path_map(size, size);
+    DistanceMap expected(size, size);
+    GenerateCostMap(f.map, s_check_cost, f.start, path_map, expected);
+
+    HexDistanceOracle oracle;
+    oracle.BuildLandmarks(f.map, s_check_cost, 8);
+    HexSearchContext context;
+    Random random(static_cast<unsigned int>(size) + 2);
+    for (int q(0); q < s_check_queries; ++q) {
+        const HexMapPosition goal = ChooseGoal(f, random, q);
+        const int cost = ExpectedCost(expected, goal);
+        const int actual = oracle.Query(f.map, s_check_cost, f.start, goal, context);
+        if (actual != cost) { return ReportMismatch("query cost", goal, cost, actual); }
+        if (cost < 0) { continue; }
+
+        const int lower = oracle.GetLowerBound(f.start, goal);
+        const int upper = oracle.GetUpperBound(f.start, goal);
+        if ((lower < 0) || (cost < lower)) { return ReportMismatch("lower bound", goal, cost, lower); }
+        if ((0 <= upper) && (upper < cost)) { return ReportMismatch("upper bound", goal, cost, upper); }
+    }
+    return true;
+}
+
+/// 階層的経路探索の経路を確かめる
+/// 到達できるか否かは最短経路と一致し, 経路は隣を辿ってコストの合計が戻り値になり, 最短より安くはならない
+/// 最短とは限らないので, コストは合計が最短の合計から一定の割合に収まることだけを求める
+bool CheckHierarchy(const Fixture& f)
+{
+    const int size = f.map.GetWidth();
+    ChipMap map(f.map);
+    HexPathHierarchy<HexMapDynamic, HexMapDynamic> hierarchy;
+    hierarchy.Build(map, s_check_cost);
+
+    PositionMap path_map(size, size);
+    DistanceMap expected(size, size);
+    std::vector<HexMapPosition> path;
+    std::vector<HexMapPosition> changed;
+    Random random(static_cast<unsigned int>(size) + 3);
+    long long total_expected(0);
+    long long total_actual(0);
+    for (int round(0); round < 2; ++round) {
+        // 二回目は地形を変えてクラスタを作り直す
+        if (0 < round) {
+            MutateTerrain(map, f.start, random, changed);
+            for (std::size_t i(0); i < changed.size(); ++i) { hierarchy.RebuildCluster(map, changed[i]); }
+        }
+        GenerateCostMap(map, s_check_cost, f.start, path_map, expected);
+
+        for (int q(0); q < s_check_queries; ++q) {
+            const HexMapPosition goal = ChooseGoal(f, random, q);
+            const int cost = ExpectedCost(expected, goal);
+            const int actual = hierarchy.FindPath(map, f.start, goal, path);
+            if ((cost < 0) != (actual < 0)) { return ReportMismatch("reachability", goal, cost, actual); }
+            if (cost < 0) { continue; }
+            if (actual < cost) { return ReportMismatch("cost below optimum", goal, cost, actual); }
+
+            int sum(0);
+            bool connected = (! path.empty()) && (path.front() == f.start) && (path.back() == goal);
+            for (std::size_t i(1); connected && (i < path.size()); ++i) {
+                connected = (HexDistance(path[i - 1], path[i]) == 1) && IsEntriable(map, s_check_cost, path[i]);
+                sum += s_check_cost(map[path[i]]);
+            }
+            if (! connected) { return ReportMismatch("broken path", goal, cost, actual); }
+            if (sum != actual) { return ReportMismatch("path cost", goal, actual, sum); }
+            total_expected += cost;
+            total_actual   += actual;
+        }
+    }
+    if (total_expected * (100 + s_max_hierarchy_excess) < total_actual * 100) {
+        std::fprintf(stderr, "  total cost %lld exceeds the optimum %lld by more than %d%%\n",
+                     total_actual, total_expected, s_max_hierarchy_excess);
+        return false;
+    }
+    return true;
+}
+
+/// 地形を変えながら更新した連結成分を, 作り直した連結成分と突き合わせる
+/// ラベルの値は異なってよいので, 二つのラベル付けが一対一に対応することを確かめる
+bool CheckComponents(const Fixture& f)
+{
+    ChipMap map(f.map);
+    HexComponentMap components;
+    components.Build(map);
+
+    HexComponentMap expected;
+    std::vector<HexMapPosition> changed;
+    std::unordered_map<int, int> forward;
+    std::unordered_map<int, int> backward;
+    Random random(static_cast<unsigned int>(map.GetWidth()) + 4);
+    for (int round(0); round < s_check_rounds; ++round) {
+        MutateTerrain(map, f.start, random, changed);
+        for (std::size_t i(0); i < changed.size(); ++i) { components.Update(map, changed[i]); }
+        expected.Build(map);
+
+        if (expected.GetComponentCount() != components.GetComponentCount()) {
+            return ReportMismatch("component count", f.start, expected.GetComponentCount(), components.GetComponentCount());
+        }
+        forward.clear();
+        backward.clear();
+        for (PositionIterator it = PositionIterator::begin(map.GetWidth(), map.GetHeight()); it != PositionIterator::end(map.GetWidth(), map.GetHeight()); ++it) {
+            const int a = expected.GetComponent(*it);
+            const int b = components.GetComponent(*it);
+            if ((a == HexComponentMap::NoComponent) || (b == HexComponentMap::NoComponent)) {
+                if (a != b) { return ReportMismatch("component", *it, a, b); }
+                continue;
+            }
+            // 初めて見たラベルならば対応を覚え, 見たことがあれば同じ対応であること
+            const int mapped_b = forward.insert(std::make_pair(a, b)).first->second;
+            const int mapped_a = backward.insert(std::make_pair(b, a)).first->second;
+            if ((mapped_b != b) || (mapped_a != a)) { return ReportMismatch("component", *it, mapped_b, b); }
+        }
+    }
+    return true;
+}
+
+/// 突き合わせの一覧
+struct CheckEntry
+{
+    const char* name; /// 探索名
+    Check check;      /// 突き合わせ
+};
+
+const CheckEntry s_checks[] = {
+    { "GeneratePathMap(tiled)",    CheckTiled },
+    { "GeneratePathMapParallel",   CheckParallel },
+    { "HexPathRepairer",           CheckRepair },
+    { "HexDistanceOracle",         CheckOracle },
+    { "HexPathHierarchy",          CheckHierarchy },
+    { "HexComponentMap",           CheckComponents },
+};
+
+/// 開始地点から到達できる位置の割合の下限 1 / s_min_reached_den
+const int s_min_reached_den = 20;
+
+/// 入力を用意する
+/// 開始地点から経路マップを作り, 到達できる位置から終点を等間隔に最大1024個選ぶ
+void Prepare(Fixture& f, Terrain terrain, int size)
+{
+    f.map.Resize(size, size);
+    BuildTerrain(terrain, f.map, static_cast<unsigned int>(size) * 31 + terrain);
+    f.start = ChooseStart(f.map);
+    f.path_map.Resize(size, size);
+    f.distance_map.Resize(size, size);
+    const int reached = GeneratePathMap(f.map, &f.start, &f.start + 1, f.path_map, f.distance_map, f.scratch);
+
+    // 到達範囲が狭いと経路の計測がループの手間だけを測ることになるので, 地形や種を変えたら気付けるようにする
+    // 計測はNDEBUGで組むのでassertではなく終了する
+    if (reached * s_min_reached_den < f.map.Size()) {
+        std::fprintf(stderr, "%s %dx%d: only %d of %d cells reachable from (%d, %d)\n",
+                     s_terrain_names[terrain], size, size, reached, f.map.Size(), f.start.X(), f.start.Y());
+        std::exit(1);
+    }
+
+    f.tiled_map.Resize(size, size);
+    f.tiled_path_map.Resize(size, size);
+    f.tiled_distance_map.Resize(size, size);
+    for (PositionIterator it = PositionIterator::begin(size, size); it != PositionIterator::end(size, size); ++it) {
+        f.tiled_map[*it] = f.map[*it];
+    }
+
+    f.targets.clear();
+    f.target_steps = 0;
+    const int step = std::max(1, reached / 1024);
+    int index(0);
+    for (PositionIterator it = PositionIterator::begin(size, size); it != PositionIterator::end(size, size); ++it) {
+        if (f.distance_map[*it] < 0) { continue; }
+        if ((index++ % step) != 0) { continue; }
+        f.targets.push_back(*it);
+        f.target_steps += f.distance_map[*it];
+    }
+}
+
+/// 一つの処理を最小の秒数以上繰り返して測る
+/// 最初の一回は領域の確保などを済ませるために測らない
+void Measure(const KernelEntry& entry, Fixture& f, const char* terrain, int size, double min_time)
+{
+    typedef std::chrono::steady_clock Clock;
+    entry.kernel(f);
+
+    const HexAllocStats before = GetHexAllocStats();
+    const Clock::time_point begin = Clock::now();
+    long long runs(0);
+    long long items(0);
+    double elapsed(0.0);
+    do {
+        items += entry.kernel(f);
+        ++runs;
+        elapsed = std::chrono::duration<double>(Clock::now() - begin).count();
+    } while (elapsed < min_time);
+    const HexAllocStats after = GetHexAllocStats();
+
+    char unit[32];
+    std::snprintf(unit, sizeof(unit), "M%s/s", entry.unit);
+    std::printf("%-24s %-8s %5d x %-5d %8lld %10.2f %-12s %10.1f %12.0f\n",
+                entry.name, terrain, size, size, runs,
+                static_cast<double>(items) / elapsed * 1.0e-6, unit,
+                static_cast<double>(after.count - before.count) / runs,
+                static_cast<double>(after.bytes - before.bytes) / runs);
+}
+
+/// 一つの探索を突き合わせて結果を表示する
+/// @retval 一致すればtrue
+bool Verify(const CheckEntry& entry, const Fixture& f, const char* terrain, int size)
+{
+    const bool ok = entry.check(f);
+    std::printf("%-24s %-8s %5d x %-5d %s\n", entry.name, terrain, size, size, ok ? "ok" : "MISMATCH");
+    return ok;
+}
+
+/// 使い方を表示する
+void PrintUsage(const char* program)
+{
+    std::fprintf(stderr,
+                 "usage: %s [--quick] [--verify] [--min-time ms] [--filter name]\n"
+                 "  --quick     small maps and short runs, with --verify (smoke test)\n"
+                 "  --verify    check each search against the reference search before measuring\n"
+                 "  --min-time  minimum time per measurement in milliseconds (default 200)\n"
+                 "  --filter    only run kernels whose name contains the string\n",
+                 program);
+}
+
+/// 引数を読む
+/// @retval 正しければtrue
+bool ParseOptions(int argc, char* argv[], Options& options)
+{
+    const int default_sizes[] = { 64, 256, 1024 };
+    options.sizes.assign(default_sizes, default_sizes + 3);
+    options.min_time = 0.2;
+    options.filter.clear();
+    options.verify = false;
+
+    for (int i(1); i < argc; ++i) {
+        if (std::strcmp(argv[i], "--quick") == 0) {
+            options.sizes.assign(1, 64);
+            options.min_time = 0.01;
+            options.verify   = true;
+        } else if (std::strcmp(argv[i], "--verify") == 0) {
+            options.verify = true;
+        } else if ((std::strcmp(argv[i], "--min-time") == 0) && (i + 1 < argc)) {
+            options.min_time = std::atof(argv[++i]) * 1.0e-3;
+        } else if ((std::strcmp(argv[i], "--filter") == 0) && (i + 1 < argc)) {
+            options.filter = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (! ParseOptions(argc, argv, options)) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    std::printf("%-24s %-8s %13s %8s %23s %10s %12s\n",
+                "kernel", "map", "size", "runs", "throughput", "allocs/run", "bytes/run");
+
+    Fixture fixture;
+    int failures(0);
+    for (std::size_t s(0); s < options.sizes.size(); ++s) {
+        for (int t(0); t < TerrainCount; ++t) {
+            const int size = options.sizes[s];
+            Prepare(fixture, static_cast<Terrain>(t), size);
+            for (std::size_t c(0); options.verify && (c < sizeof(s_checks) / sizeof(s_checks[0])); ++c) {
+                const CheckEntry& entry = s_checks[c];
+                if ((! options.filter.empty()) && (std::strstr(entry.name, options.filter.c_str()) == NULL)) { continue; }
+                if (! Verify(entry, fixture, s_terrain_names[t], size)) { ++failures; }
+            }
+            for (std::size_t k(0); k < sizeof(s_kernels) / sizeof(s_kernels[0]); ++k) {
+                const KernelEntry& entry = s_kernels[k];
+                if ((! options.filter.empty()) && (std::strstr(entry.name, options.filter.c_str()) == NULL)) { continue; }
+                Measure(entry, fixture, s_terrain_names[t], size, options.min_time);
+            }
+        }
+    }
+
+    if (0 < failures) {
+        std::fprintf(stderr, "%d check(s) did not match the reference search\n", failures);
+        return 1;
+    }
+    // 結果を一度読んで, 処理が最適化で消えないようにする
+    return (s_sink == -1) ? 2 : 0;
+}